@@ -1,3 +1,7 @@
+// 1 = enviar tramas verificadas "#<secuencia>,<TIPO>,<DATO>*<CRC-32C>"
+//     (usar con: decodificador --verificado)
+#define TRAMAS_VERIFICADAS 0
+
 const char* tramas[] = {
   "L,H",
   "L,O",
@@ -13,6 +17,28 @@ const char* tramas[] = {
   "L,D"
 };
 
+unsigned long secuencia = 0;
+
+uint32_t crc32c(const char* datos, size_t longitud) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < longitud; i++) {
+    crc ^= (uint8_t)datos[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : (crc >> 1);
+    }
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+void enviarTramaVerificada(const char* trama) {
+  char contenido[40];
+  char salida[56];
+  snprintf(contenido, sizeof(contenido), "%lu,%s", secuencia++, trama);
+  snprintf(salida, sizeof(salida), "#%s*%08lX", contenido,
+           (unsigned long)crc32c(contenido, strlen(contenido)));
+  Serial.println(salida);
+}
+
 void setup() {
   // put your setup code here, to run once:
   Serial.begin(9600);
@@ -23,7 +49,11 @@ void setup() {
 void loop() {
   // put your main code here, to run repeatedly:
   for (const char* trama : tramas) {
+#if TRAMAS_VERIFICADAS
+    enviarTramaVerificada(trama);
+#else
     Serial.println(trama);
+#endif
   }
   delay(1000);
 }
@@ -0,0 +1,110 @@
+/**
+ * @file AlertasPalabras.h
+ * @brief Detector incremental de palabras clave (Aho-Corasick) sobre el mensaje decodificado
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ALERTASPALABRAS_H
+#define ALERTASPALABRAS_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class AlertasPalabras
+ * @brief Autómata Aho-Corasick que avanza un estado por cada carácter decodificado
+ *
+ * Se construye una sola vez a partir de una lista de palabras (por ejemplo,
+ * un archivo con una palabra por línea). Después, avanzar() consume cada
+ * carácter en el momento en que TramaLoad lo agrega a la ListaDeCarga, sin
+ * volver a recorrer el mensaje: la alerta se dispara en la misma trama que
+ * completa la palabra.
+ *
+ * La tabla de transiciones es densa (256 entradas por estado), por lo que
+ * cada carácter cuesta una sola consulta más el recorrido de las coincidencias.
+ * La comparación no distingue mayúsculas de minúsculas (ASCII).
+ */
+class AlertasPalabras
+{
+public:
+    /**
+     * @brief Callback de coincidencia
+     *
+     * Recibe la palabra detectada y su posición [inicio, fin) dentro del
+     * mensaje actual (índices de carácter desde el último reiniciar()).
+     */
+    std::function<void(const char* palabra, std::size_t inicio, std::size_t fin)> alDetectar;
+
+    /**
+     * @brief Constructor: autómata vacío (sin palabras)
+     */
+    AlertasPalabras();
+
+    /**
+     * @brief Agrega una palabra clave
+     * @param palabra Palabra a detectar (se ignoran las vacías)
+     *
+     * Invalida el autómata: debe llamarse construir() antes de avanzar().
+     */
+    void agregarPalabra(const std::string& palabra);
+
+    /**
+     * @brief Carga palabras desde un archivo (una por línea) y construye el autómata
+     * @param ruta Ruta del archivo de palabras clave
+     * @return true si el archivo se leyó y contenía al menos una palabra
+     *
+     * Las líneas vacías y las que empiezan con '#' se ignoran.
+     */
+    bool cargarArchivo(const std::string& ruta);
+
+    /**
+     * @brief Calcula los enlaces de fallo y la tabla de transiciones completa
+     *
+     * Complejidad: O(total de caracteres de las palabras * 256)
+     */
+    void construir();
+
+    /**
+     * @brief Consume un carácter del mensaje decodificado
+     * @param caracter Carácter recién agregado al mensaje
+     *
+     * Dispara alDetectar una vez por cada palabra que termina en este carácter.
+     */
+    void avanzar(char caracter);
+
+    /**
+     * @brief Vuelve al estado inicial (nuevo mensaje)
+     */
+    void reiniciar();
+
+    /**
+     * @brief Cantidad de palabras cargadas
+     * @return Número de palabras clave
+     */
+    std::size_t cantidadPalabras() const { return palabras.size(); }
+
+private:
+    static const int ALFABETO = 256;  ///< Transiciones por estado (un byte)
+
+    /**
+     * @brief Normaliza un carácter para la comparación sin mayúsculas
+     * @param caracter Carácter de entrada
+     * @return Índice de columna en la tabla de transiciones
+     */
+    static unsigned char normalizar(char caracter);
+
+    std::vector<std::string> palabras;   ///< Palabras clave originales
+    std::vector<int> transiciones;       ///< Tabla densa estados x ALFABETO
+    std::vector<int> fallo;              ///< Enlace de fallo de cada estado
+    std::vector<int> palabraFinal;       ///< Palabra que termina en el estado (-1 = ninguna)
+    std::vector<int> enlaceSalida;       ///< Estado sufijo más cercano con palabra (-1 = ninguno)
+    bool construido;                     ///< true si la tabla está completa
+    int estado;                          ///< Estado actual del autómata
+    std::size_t posicion;                ///< Caracteres consumidos desde reiniciar()
+};
+
+#endif
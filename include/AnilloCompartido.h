@@ -0,0 +1,485 @@
+/**
+ * @file AnilloCompartido.h
+ * @brief Anillo en memoria compartida POSIX para publicar la salida decodificada
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ANILLOCOMPARTIDO_H
+#define ANILLOCOMPARTIDO_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "El anillo requiere atomicos de 64 bits sin bloqueo");
+
+/**
+ * @struct EventoAnillo
+ * @brief Evento publicado en el anillo: un carácter decodificado o un fin de mensaje
+ */
+struct EventoAnillo
+{
+    enum Tipo { CARACTER = 1, FIN_MENSAJE = 2 };
+
+    Tipo tipo;           ///< Clase de evento
+    char caracter;       ///< Carácter decodificado (sólo CARACTER)
+    uint32_t mensaje;    ///< Número de mensaje al que pertenece el evento
+    uint64_t secuencia;  ///< Posición global del evento en el anillo
+};
+
+/**
+ * @struct RegionAnillo
+ * @brief Disposición binaria del segmento compartido
+ *
+ * Cada ranura es un seqlock: el productor marca la ranura como "en escritura"
+ * (valor impar), guarda el dato y la publica con 2 * secuencia + 2. Los
+ * lectores validan la marca antes y después de copiar el dato.
+ *
+ * Un segmento nunca se reutiliza: cada ejecución del productor crea uno nuevo
+ * y marca el anterior como finalizado para que sus lectores se cambien.
+ */
+struct RegionAnillo
+{
+    static const uint32_t MAGICO = 0x50525437;  ///< "PRT7"
+    static const uint32_t VERSION = 2;          ///< Versión del formato
+
+    /**
+     * @struct Ranura
+     * @brief Posición del anillo con su marca de secuencia
+     */
+    struct Ranura
+    {
+        std::atomic<uint64_t> marca;  ///< 2*s+1 escribiendo, 2*s+2 publicada
+        std::atomic<uint64_t> dato;   ///< tipo | caracter << 8 | mensaje << 32
+    };
+
+    uint32_t magico;                               ///< Identificador del formato
+    uint32_t version;                              ///< Versión del formato
+    uint32_t capacidad;                            ///< Número de ranuras (potencia de 2)
+    std::atomic<uint32_t> finalizado;              ///< 1 si el productor cerró o reemplazó el segmento
+    alignas(64) std::atomic<uint64_t> escritura;   ///< Siguiente secuencia a publicar
+    alignas(64) Ranura ranuras[1];                 ///< Ranuras (capacidad elementos)
+
+    /**
+     * @brief Bytes necesarios para una región con la capacidad indicada
+     * @param capacidad Número de ranuras
+     * @return Tamaño total del segmento
+     */
+    static size_t tamano(uint32_t capacidad) {
+        return offsetof(RegionAnillo, ranuras) + sizeof(Ranura) * capacidad;
+    }
+};
+
+/**
+ * @class AnilloCompartido
+ * @brief Productor único de un anillo SPMC en memoria compartida
+ *
+ * Publica los caracteres decodificados y los fines de mensaje en un segmento
+ * POSIX (shm_open) que varios procesos locales pueden leer sin llamadas al
+ * sistema por mensaje. El productor nunca espera: si un lector se retrasa más
+ * que la capacidad del anillo, sus eventos más antiguos se sobrescriben y el
+ * lector lo detecta como pérdida.
+ */
+class AnilloCompartido
+{
+private:
+    RegionAnillo* region;   ///< Segmento mapeado
+    size_t tamanoRegion;    ///< Tamaño del mapeo
+    std::string nombre;     ///< Nombre del segmento (p. ej. "/prt7")
+    uint64_t siguiente;     ///< Copia local de region->escritura
+    uint32_t mensajeActual; ///< Número del mensaje en curso
+
+public:
+    /**
+     * @brief Constructor por defecto
+     */
+    AnilloCompartido() : region(nullptr), tamanoRegion(0), siguiente(0), mensajeActual(0) {}
+
+    /**
+     * @brief Crea el segmento compartido, reemplazando el de una ejecución anterior
+     * @param nombreSegmento Nombre POSIX que empieza con '/' (ejemplo: /prt7)
+     * @param capacidad Número de ranuras; se redondea a potencia de 2
+     * @return true si el segmento quedó listo para publicar
+     */
+    bool crear(const std::string& nombreSegmento, uint32_t capacidad = 4096) {
+        uint32_t ranuras = 1;
+        while (ranuras < capacidad) {
+            ranuras <<= 1;
+        }
+
+        // No reutilizar el segmento anterior: truncarlo bajo lectores aún
+        // conectados provocaría SIGBUS y les ocultaría el reinicio
+        finalizarAnterior(nombreSegmento);
+        shm_unlink(nombreSegmento.c_str());
+
+        int descriptor = shm_open(nombreSegmento.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (descriptor < 0) {
+            std::cerr << "[ERROR] No se pudo crear la memoria compartida " << nombreSegmento << std::endl;
+            return false;
+        }
+
+        size_t tamano = RegionAnillo::tamano(ranuras);
+        if (ftruncate(descriptor, static_cast<off_t>(tamano)) < 0) {
+            std::cerr << "[ERROR] No se pudo dimensionar " << nombreSegmento << std::endl;
+            close(descriptor);
+            shm_unlink(nombreSegmento.c_str());
+            return false;
+        }
+
+        void* mapeo = mmap(nullptr, tamano, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        close(descriptor);
+        if (mapeo == MAP_FAILED) {
+            std::cerr << "[ERROR] No se pudo mapear " << nombreSegmento << std::endl;
+            shm_unlink(nombreSegmento.c_str());
+            return false;
+        }
+
+        // El segmento recién truncado está en ceros: basta con construir los atómicos
+        region = static_cast<RegionAnillo*>(mapeo);
+        new (&region->escritura) std::atomic<uint64_t>(0);
+        new (&region->finalizado) std::atomic<uint32_t>(0);
+        for (uint32_t i = 0; i < ranuras; i++) {
+            new (&region->ranuras[i].marca) std::atomic<uint64_t>(0);
+            new (&region->ranuras[i].dato) std::atomic<uint64_t>(0);
+        }
+        region->capacidad = ranuras;
+        region->version = RegionAnillo::VERSION;
+        std::atomic_thread_fence(std::memory_order_release);
+        region->magico = RegionAnillo::MAGICO;
+
+        tamanoRegion = tamano;
+        nombre = nombreSegmento;
+        siguiente = 0;
+        mensajeActual = 0;
+
+        std::cout << "[OK] Anillo " << nombre << " publicado con " << ranuras << " ranuras" << std::endl;
+        return true;
+    }
+
+    /**
+     * @brief Publica un carácter decodificado
+     * @param caracter Carácter a publicar
+     */
+    void publicarCaracter(char caracter) {
+        publicar(EventoAnillo::CARACTER, caracter);
+    }
+
+    /**
+     * @brief Publica el fin del mensaje en curso e inicia el siguiente
+     */
+    void publicarFinMensaje() {
+        publicar(EventoAnillo::FIN_MENSAJE, '\0');
+        mensajeActual++;
+    }
+
+    /**
+     * @brief Consulta si el anillo está creado
+     * @return true si se puede publicar
+     */
+    bool estaAbierto() const {
+        return region != nullptr;
+    }
+
+    /**
+     * @brief Desmapea y elimina el segmento compartido
+     *
+     * Los lectores que ya lo tenían mapeado conservan su copia hasta cerrarla
+     * y ven el segmento como finalizado.
+     */
+    void cerrar() {
+        if (region != nullptr) {
+            region->finalizado.store(1, std::memory_order_release);
+            munmap(region, tamanoRegion);
+            shm_unlink(nombre.c_str());
+            region = nullptr;
+        }
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~AnilloCompartido() {
+        cerrar();
+    }
+
+private:
+    /**
+     * @brief Marca como finalizado el segmento que dejó una ejecución anterior
+     * @param nombreSegmento Nombre POSIX del segmento
+     *
+     * Cubre el caso de un productor que terminó sin llamar a cerrar(): sus
+     * lectores se enteran del reinicio sin hacer llamadas al sistema.
+     */
+    static void finalizarAnterior(const std::string& nombreSegmento) {
+        int descriptor = shm_open(nombreSegmento.c_str(), O_RDWR, 0);
+        if (descriptor < 0) {
+            return;
+        }
+
+        struct stat informacion;
+        if (fstat(descriptor, &informacion) == 0
+            && informacion.st_size >= static_cast<off_t>(RegionAnillo::tamano(1))) {
+            void* mapeo = mmap(nullptr, sizeof(RegionAnillo), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+            if (mapeo != MAP_FAILED) {
+                RegionAnillo* anterior = static_cast<RegionAnillo*>(mapeo);
+                if (anterior->magico == RegionAnillo::MAGICO && anterior->version == RegionAnillo::VERSION) {
+                    anterior->finalizado.store(1, std::memory_order_release);
+                }
+                munmap(mapeo, sizeof(RegionAnillo));
+            }
+        }
+        close(descriptor);
+    }
+
+    /**
+     * @brief Escribe un evento en la siguiente ranura (nunca bloquea)
+     * @param tipo Tipo de evento
+     * @param caracter Carácter asociado
+     */
+    void publicar(EventoAnillo::Tipo tipo, char caracter) {
+        if (region == nullptr) {
+            return;
+        }
+
+        RegionAnillo::Ranura& ranura = region->ranuras[siguiente & (region->capacidad - 1)];
+        uint64_t dato = static_cast<uint64_t>(tipo)
+                      | (static_cast<uint64_t>(static_cast<unsigned char>(caracter)) << 8)
+                      | (static_cast<uint64_t>(mensajeActual) << 32);
+
+        ranura.marca.store(2 * siguiente + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        ranura.dato.store(dato, std::memory_order_relaxed);
+        ranura.marca.store(2 * siguiente + 2, std::memory_order_release);
+
+        siguiente++;
+        region->escritura.store(siguiente, std::memory_order_release);
+    }
+
+    AnilloCompartido(const AnilloCompartido&);             ///< No copiable
+    AnilloCompartido& operator=(const AnilloCompartido&);  ///< No asignable
+};
+
+/**
+ * @class LectorAnillo
+ * @brief Consumidor de un AnilloCompartido; puede haber cualquier cantidad
+ *
+ * Cada lector mantiene su propio cursor y sólo lee memoria compartida: no
+ * escribe nada en el segmento, por lo que nunca frena al productor ni a
+ * otros lectores.
+ *
+ * Si el productor se reinicia con el mismo nombre, el segmento anterior
+ * queda finalizado y el lector se cambia al nuevo desde su primer evento;
+ * reinicios() cuenta estos cambios.
+ */
+class LectorAnillo
+{
+private:
+    const RegionAnillo* region;  ///< Segmento mapeado (sólo lectura)
+    size_t tamanoRegion;         ///< Tamaño del mapeo
+    uint32_t capacidad;          ///< Ranuras del segmento mapeado (fijada al conectar)
+    std::string nombre;          ///< Nombre del segmento (para seguir al productor)
+    uint64_t cursor;             ///< Siguiente secuencia a leer
+    uint64_t totalPerdidos;      ///< Eventos sobrescritos antes de leerlos
+    uint64_t totalReinicios;     ///< Cambios a un segmento nuevo del productor
+
+    /**
+     * @brief Mapea el segmento actual del nombre sin mostrar mensajes
+     * @param desdeInicio true para empezar en el evento más antiguo retenido
+     * @return true si el segmento existe y tiene un formato válido
+     *
+     * Si falla, el lector conserva el segmento que tenía mapeado.
+     */
+    bool mapear(bool desdeInicio) {
+        int descriptor = shm_open(nombre.c_str(), O_RDONLY, 0);
+        if (descriptor < 0) {
+            return false;
+        }
+
+        struct stat informacion;
+        void* mapeo = MAP_FAILED;
+        size_t tamano = 0;
+        if (fstat(descriptor, &informacion) == 0
+            && informacion.st_size >= static_cast<off_t>(RegionAnillo::tamano(1))) {
+            tamano = static_cast<size_t>(informacion.st_size);
+            mapeo = mmap(nullptr, tamano, PROT_READ, MAP_SHARED, descriptor, 0);
+        }
+        close(descriptor);
+        if (mapeo == MAP_FAILED) {
+            return false;
+        }
+
+        const RegionAnillo* candidata = static_cast<const RegionAnillo*>(mapeo);
+        uint32_t ranuras = candidata->capacidad;
+        if (candidata->magico != RegionAnillo::MAGICO || candidata->version != RegionAnillo::VERSION
+            || ranuras == 0 || (ranuras & (ranuras - 1)) != 0
+            || RegionAnillo::tamano(ranuras) > tamano) {
+            munmap(mapeo, tamano);
+            return false;
+        }
+
+        cerrar();
+        region = candidata;
+        tamanoRegion = tamano;
+        capacidad = ranuras;
+        uint64_t escritura = region->escritura.load(std::memory_order_acquire);
+        cursor = escritura;
+        if (desdeInicio) {
+            cursor = (escritura > capacidad) ? escritura - capacidad : 0;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Detecta un reinicio del productor y se cambia a su segmento nuevo
+     * @param escritura Valor actual de region->escritura
+     * @return true si el lector pasó a otro segmento (o reinició el cursor)
+     *
+     * Sólo se consulta cuando el lector está al día, así que no agrega
+     * llamadas al sistema por evento.
+     */
+    bool seguirProductor(uint64_t escritura) {
+        if (escritura < cursor) {
+            // Segmento reiniciado en el lugar por un productor antiguo
+            cursor = 0;
+            totalReinicios++;
+            return true;
+        }
+
+        if (region->finalizado.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+
+        // Mientras el productor nuevo no termine de crear su segmento,
+        // mapear() falla y se vuelve a intentar en la siguiente lectura
+        if (!mapear(true)) {
+            return false;
+        }
+        totalReinicios++;
+        return true;
+    }
+
+public:
+    /**
+     * @brief Constructor por defecto
+     */
+    LectorAnillo()
+        : region(nullptr), tamanoRegion(0), capacidad(0), cursor(0), totalPerdidos(0), totalReinicios(0) {}
+
+    /**
+     * @brief Se conecta a un anillo existente
+     * @param nombreSegmento Nombre POSIX usado por el productor
+     * @param desdeInicio true para leer los eventos aún retenidos; false para leer sólo los nuevos
+     * @return true si el segmento existe y tiene un formato válido
+     */
+    bool conectar(const std::string& nombreSegmento, bool desdeInicio = false) {
+        cerrar();
+        nombre = nombreSegmento;
+        totalPerdidos = 0;
+        totalReinicios = 0;
+
+        if (!mapear(desdeInicio)) {
+            std::cerr << "[ERROR] No existe un anillo valido en " << nombreSegmento << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Lee el siguiente evento sin bloquear
+     * @param evento Destino del evento leído
+     * @return true si había un evento nuevo, false si el lector está al día
+     *
+     * Si el productor sobrescribió eventos no leídos, el cursor salta al
+     * evento más antiguo disponible y la diferencia se suma a perdidos().
+     * Si el productor se reinició, continúa con el primer evento del segmento
+     * nuevo y suma uno a reinicios().
+     */
+    bool leer(EventoAnillo& evento) {
+        if (region == nullptr) {
+            return false;
+        }
+
+        while (true) {
+            uint64_t escritura = region->escritura.load(std::memory_order_acquire);
+            if (cursor >= escritura) {
+                if (seguirProductor(escritura)) {
+                    continue;
+                }
+                return false;
+            }
+            if (escritura - cursor > capacidad) {
+                totalPerdidos += escritura - capacidad - cursor;
+                cursor = escritura - capacidad;
+            }
+
+            const RegionAnillo::Ranura& ranura = region->ranuras[cursor & (capacidad - 1)];
+            uint64_t esperada = 2 * cursor + 2;
+            uint64_t marcaAntes = ranura.marca.load(std::memory_order_acquire);
+            uint64_t dato = ranura.dato.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t marcaDespues = ranura.marca.load(std::memory_order_relaxed);
+
+            if (marcaAntes != esperada || marcaDespues != esperada) {
+                // La ranura fue reutilizada mientras se leía: el evento se perdió
+                totalPerdidos++;
+                cursor++;
+                continue;
+            }
+
+            evento.tipo = static_cast<EventoAnillo::Tipo>(dato & 0xFF);
+            evento.caracter = static_cast<char>((dato >> 8) & 0xFF);
+            evento.mensaje = static_cast<uint32_t>(dato >> 32);
+            evento.secuencia = cursor;
+            cursor++;
+            return true;
+        }
+    }
+
+    /**
+     * @brief Eventos perdidos por lentitud del lector
+     * @return Total de eventos sobrescritos antes de ser leídos
+     */
+    uint64_t perdidos() const {
+        return totalPerdidos;
+    }
+
+    /**
+     * @brief Reinicios del productor detectados
+     * @return Veces que el lector pasó a un segmento nuevo
+     */
+    uint64_t reinicios() const {
+        return totalReinicios;
+    }
+
+    /**
+     * @brief Desmapea el segmento
+     */
+    void cerrar() {
+        if (region != nullptr) {
+            munmap(const_cast<RegionAnillo*>(region), tamanoRegion);
+            region = nullptr;
+        }
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~LectorAnillo() {
+        cerrar();
+    }
+
+private:
+    LectorAnillo(const LectorAnillo&);             ///< No copiable
+    LectorAnillo& operator=(const LectorAnillo&);  ///< No asignable
+};
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file Canal.h
+ * @brief Canal acotado entre etapas de corrutinas de un mismo Reactor
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ *
+ * @note Requiere C++20 (corrutinas). Sólo lo utiliza el ejecutable decodificador_async.
+ */
+
+#ifndef CANAL_H
+#define CANAL_H
+
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include "Reactor.h"
+
+/**
+ * @class Canal
+ * @brief Buffer circular de capacidad fija con envío y recepción suspendibles
+ * @tparam T Tipo de elemento transportado
+ * @tparam N Capacidad máxima del canal
+ *
+ * Conecta exactamente una etapa productora con una etapa consumidora que
+ * corren en el mismo Reactor. Si el canal está lleno, enviar() suspende al
+ * productor; si está vacío, recibir() suspende al consumidor. Así la memoria
+ * entre etapas queda acotada y una etapa lenta frena a la anterior.
+ */
+template <typename T, std::size_t N>
+class Canal
+{
+public:
+    /**
+     * @brief Constructor
+     * @param r Reactor donde se reanudan las etapas suspendidas
+     */
+    explicit Canal(Reactor& r) : reactor(r), inicio(0), cantidad(0), cerrado(false) {}
+
+    Canal(const Canal&) = delete;
+    Canal& operator=(const Canal&) = delete;
+
+    /**
+     * @struct Envio
+     * @brief Awaitable devuelto por enviar()
+     */
+    struct Envio
+    {
+        Canal& canal;  ///< Canal destino
+        T valor;       ///< Elemento a depositar
+
+        bool await_ready() const noexcept { return canal.cantidad < N || canal.cerrado; }
+        void await_suspend(std::coroutine_handle<> h) noexcept { canal.productor = h; }
+        void await_resume() { canal.depositar(std::move(valor)); }
+    };
+
+    /**
+     * @struct Recepcion
+     * @brief Awaitable devuelto por recibir()
+     */
+    struct Recepcion
+    {
+        Canal& canal;  ///< Canal origen
+
+        bool await_ready() const noexcept { return canal.cantidad > 0 || canal.cerrado; }
+        void await_suspend(std::coroutine_handle<> h) noexcept { canal.consumidor = h; }
+        std::optional<T> await_resume() { return canal.extraer(); }
+    };
+
+    /**
+     * @brief Envía un elemento, suspendiendo si el canal está lleno
+     * @param valor Elemento a enviar (se descarta si el canal está cerrado)
+     */
+    Envio enviar(T valor) { return Envio{*this, std::move(valor)}; }
+
+    /**
+     * @brief Recibe un elemento, suspendiendo si el canal está vacío
+     * @return El elemento, o std::nullopt si el canal se cerró y está vacío
+     */
+    Recepcion recibir() { return Recepcion{*this}; }
+
+    /**
+     * @brief Cierra el canal: el consumidor recibirá std::nullopt al vaciarlo
+     */
+    void cerrar() {
+        cerrado = true;
+        despertar(consumidor);
+    }
+
+private:
+    void depositar(T valor) {
+        if (cerrado) {
+            return;
+        }
+        elementos[(inicio + cantidad) % N] = std::move(valor);
+        cantidad++;
+        despertar(consumidor);
+    }
+
+    std::optional<T> extraer() {
+        if (cantidad == 0) {
+            return std::nullopt;
+        }
+        std::optional<T> valor(std::move(elementos[inicio]));
+        inicio = (inicio + 1) % N;
+        cantidad--;
+        despertar(productor);
+        return valor;
+    }
+
+    void despertar(std::coroutine_handle<>& h) {
+        if (h) {
+            reactor.programar(h);
+            h = nullptr;
+        }
+    }
+
+    Reactor& reactor;                  ///< Reactor compartido por ambas etapas
+    T elementos[N];                    ///< Almacenamiento circular
+    std::size_t inicio;                ///< Índice del elemento más antiguo
+    std::size_t cantidad;              ///< Elementos almacenados
+    bool cerrado;                      ///< true tras cerrar()
+    std::coroutine_handle<> productor; ///< Productor suspendido por canal lleno
+    std::coroutine_handle<> consumidor;///< Consumidor suspendido por canal vacío
+};
+
+#endif
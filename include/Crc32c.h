@@ -0,0 +1,35 @@
+/**
+ * @file Crc32c.h
+ * @brief Cálculo de CRC-32C (Castagnoli) para tramas PRT-7 verificadas
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Calcula el CRC-32C de un bloque de bytes
+ * @param datos Bytes a procesar
+ * @param longitud Cantidad de bytes
+ * @return CRC-32C (polinomio 0x1EDC6F41, valor inicial y final 0xFFFFFFFF)
+ *
+ * Utiliza la instrucción crc32 de SSE4.2 (x86) o de ARMv8 cuando el
+ * procesador la soporta; en otro caso recurre a una tabla de 256 entradas.
+ * La selección se hace una sola vez, en la primera llamada.
+ *
+ * Ejemplo: crc32c("123456789", 9) == 0xE3069283
+ */
+uint32_t crc32c(const char* datos, std::size_t longitud);
+
+/**
+ * @brief Indica si crc32c() usa instrucciones de hardware
+ * @return true si se detectó soporte de CRC-32C en el procesador
+ */
+bool crc32cAcelerado();
+
+#endif
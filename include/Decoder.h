@@ -0,0 +1,195 @@
+/**
+ * @file Decoder.h
+ * @brief Decodificador PRT-7 reutilizable alimentado por bloques de bytes
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef DECODER_H
+#define DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "Enmarcador.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @class Decoder
+ * @brief Decodificador del protocolo PRT-7 con interfaz de empuje (push)
+ *
+ * Encapsula la lista de carga, el rotor de mapeo y el parser de tramas que
+ * antes vivían como globales en main.cpp. Acepta bloques de bytes de cualquier
+ * tamaño mediante feed(); las líneas incompletas se conservan entre llamadas
+ * hasta recibir su terminador (CR o LF).
+ *
+ * Los resultados se entregan a través de callbacks opcionales:
+ * - alRecibirTrama: cada línea no vacía antes de procesarse
+ * - alRechazarTrama: líneas con formato inválido o comando desconocido
+ * - alDecodificar: cada carácter agregado a la lista de carga
+ * - alFinalizarMensaje: el mensaje ensamblado al llamar finalizarMensaje()
+ *
+ * Con habilitarVerificacion(true) sólo acepta tramas verificadas con el formato
+ * "#<secuencia>,<TIPO>,<DATO>*<CRC>", donde CRC son 8 dígitos hexadecimales del
+ * CRC-32C de "<secuencia>,<TIPO>,<DATO>". Las tramas corruptas se rechazan sin
+ * tocar el rotor y los huecos de secuencia se contabilizan como pérdidas.
+ *
+ * @note El decodificador no imprime nada; la presentación es responsabilidad del cliente
+ */
+class Decoder
+{
+public:
+    /**
+     * @struct EstadisticasTramas
+     * @brief Contadores de integridad del modo verificado
+     */
+    struct EstadisticasTramas
+    {
+        unsigned long validas;    ///< Tramas con CRC correcto
+        unsigned long corruptas;  ///< Tramas rechazadas por CRC o formato
+        unsigned long perdidas;   ///< Tramas faltantes según la secuencia
+        unsigned long duplicadas; ///< Tramas íntegras rechazadas por secuencia repetida
+    };
+
+    static const int LONGITUD_MAXIMA_TRAMA = Enmarcador::LONGITUD_MAXIMA_TRAMA;  ///< Tamaño del buffer de línea (incluye '\0')
+
+    std::function<void(const char* trama)> alRecibirTrama;                        ///< Trama recibida
+    std::function<void(const char* trama, const char* motivo)> alRechazarTrama;   ///< Trama descartada
+    std::function<void(char caracter)> alDecodificar;                             ///< Carácter decodificado
+    std::function<void(ListaDeCarga& mensaje)> alFinalizarMensaje;                ///< Fin de mensaje
+
+    /**
+     * @brief Constructor
+     *
+     * Inicializa la lista de carga vacía y el rotor con cabeza en 'A'.
+     */
+    Decoder();
+
+    /**
+     * @brief Alimenta el decodificador con un bloque de bytes
+     * @param datos Bytes recibidos (no requiere terminador '\0')
+     * @param longitud Cantidad de bytes en datos
+     * @return Número de tramas completas procesadas en esta llamada
+     *
+     * Las tramas pueden quedar partidas entre llamadas consecutivas.
+     * Los caracteres que excedan LONGITUD_MAXIMA_TRAMA - 1 se descartan,
+     * igual que en SerialPort::leerLinea().
+     */
+    std::size_t feed(const char* datos, std::size_t longitud);
+
+    /**
+     * @brief Parsea y procesa una trama ya separada
+     * @param trama Trama terminada en '\0' sin CR/LF (formato "X,Y")
+     *
+     * Útil cuando el enmarcado se realiza en otra etapa (ver Enmarcador).
+     */
+    void procesarTrama(const char* trama);
+
+    /**
+     * @brief Activa o desactiva el modo de tramas verificadas (secuencia + CRC-32C)
+     * @param activo true para exigir tramas "#<secuencia>,<TIPO>,<DATO>*<CRC>"
+     *
+     * En modo verificado el carácter '#' marca el inicio de trama, de modo que
+     * tras un error el decodificador se resincroniza en el siguiente '#'
+     * aunque el terminador de línea se haya perdido.
+     */
+    void habilitarVerificacion(bool activo);
+
+    /**
+     * @brief Marcador de inicio de trama del modo actual
+     * @return '#' en modo verificado, '\0' (sin marcador) en caso contrario
+     *
+     * Los clientes que separan las tramas por su cuenta y las entregan con
+     * procesarTrama() deben configurar su Enmarcador con este valor.
+     */
+    char inicioTrama() const { return verificacion ? '#' : '\0'; }
+
+    /**
+     * @brief Consulta los contadores del modo verificado
+     * @return Copia de las estadísticas acumuladas
+     */
+    EstadisticasTramas estadisticas() const { return contadores; }
+
+    /**
+     * @brief Marca el fin del mensaje actual
+     *
+     * Entrega el mensaje ensamblado a alFinalizarMensaje y vacía la lista
+     * de carga. El estado del rotor se conserva para el siguiente mensaje.
+     */
+    void finalizarMensaje();
+
+    /**
+     * @brief Descarta la línea parcial pendiente (por ejemplo, tras una desconexión)
+     */
+    void descartarParcial();
+
+    /**
+     * @brief Consulta el total de tramas no vacías recibidas
+     * @return Número de tramas recibidas desde la construcción
+     */
+    unsigned long tramasRecibidas() const { return totalTramas; }
+
+    /**
+     * @brief Consulta el total de tramas válidas aplicadas (LOAD o MAP)
+     * @return Número de tramas que modificaron la lista o el rotor
+     *
+     * Permite detectar que el dispositivo ya está transmitiendo tramas
+     * reconocibles (y no ruido de arranque).
+     */
+    unsigned long tramasAplicadas() const { return totalAplicadas; }
+
+    /**
+     * @brief Acceso al mensaje en construcción
+     * @return Referencia a la lista de carga interna
+     */
+    ListaDeCarga& mensaje() { return listaCarga; }
+
+    /**
+     * @brief Acceso al rotor de mapeo
+     * @return Referencia al rotor interno
+     */
+    RotorDeMapeo& rotor() { return rotorMapeo; }
+
+private:
+    /**
+     * @brief Interpreta una carga útil "X,Y" ya validada y la aplica
+     * @param trama Trama original (para los callbacks de rechazo)
+     * @param lineas Carga útil en formato "X,Y"
+     */
+    void interpretarTrama(const char* trama, const char* lineas);
+
+    static const uint32_t VENTANA_REPETICION = 64;  ///< Retroceso máximo tratado como retransmisión
+
+    /**
+     * @brief Valida formato y CRC de una trama verificada
+     * @param trama Trama completa "#<secuencia>,<TIPO>,<DATO>*<CRC>"
+     * @param carga Buffer de salida para "<TIPO>,<DATO>" (LONGITUD_MAXIMA_TRAMA bytes)
+     * @param secuencia Número de secuencia de la trama
+     * @return true si la trama es íntegra
+     */
+    bool validarTrama(const char* trama, char* carga, uint32_t& secuencia);
+
+    /**
+     * @brief Contabiliza la secuencia de una trama íntegra
+     * @param secuencia Número de secuencia recibido
+     * @return false si la trama repite una secuencia reciente (duplicado)
+     */
+    bool aceptarSecuencia(uint32_t secuencia);
+
+    ListaDeCarga listaCarga;               ///< Mensaje decodificado en construcción
+    RotorDeMapeo rotorMapeo;               ///< Rotor circular para el mapeo de caracteres
+    Enmarcador enmarcador;                 ///< Línea parcial acumulada entre llamadas a feed()
+    unsigned long totalTramas;             ///< Tramas no vacías recibidas
+    unsigned long totalAplicadas;          ///< Tramas LOAD/MAP aplicadas
+    bool verificacion;                     ///< true en modo de tramas verificadas
+    bool haySecuencia;                     ///< true tras la primera trama verificada
+    uint32_t ultimaSecuencia;              ///< Secuencia de la última trama verificada
+    EstadisticasTramas contadores;         ///< Contadores de integridad
+
+    Decoder(const Decoder&);               ///< No copiable (posee listas enlazadas)
+    Decoder& operator=(const Decoder&);    ///< No asignable
+};
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file Encoder.h
+ * @brief Codificador PRT-7: genera tramas L/M a partir de texto plano
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class Encoder
+ * @brief Inversa de Decoder: convierte texto plano en un flujo de tramas PRT-7
+ *
+ * Invierte RotorDeMapeo::getMapeo(): con el rotor desplazado 'o' posiciones,
+ * la letra 'p' se transmite como (p - o) mod 26. Los caracteres que el rotor
+ * no transforma (espacios, minúsculas, dígitos...) se transmiten tal cual.
+ *
+ * Planificación de rotaciones: como cualquier letra absorbe el desplazamiento
+ * actual, el costo de las tramas LOAD no depende del rotor. Los bytes en el
+ * cable sólo dependen de cuántas tramas MAP se emiten y de su ancho, así que
+ * el planificador:
+ * - rota sólo cuando la política lo exige, justo antes de la letra que
+ *   excedería el máximo (nunca al final ni antes de caracteres no afectados);
+ * - elige entre los giros permitidos los de texto más corto ("M,3" antes que
+ *   "M,-3" o "M,16"), alternando entre empates con un generador determinista.
+ *
+ * El flujo generado asume un Decoder recién creado (rotor con cabeza en 'A').
+ */
+class Encoder
+{
+public:
+    /**
+     * @struct PoliticaRotacion
+     * @brief Restricciones de rotación que el flujo debe cumplir
+     */
+    struct PoliticaRotacion
+    {
+        int maximoCargas;     ///< Máximo de letras seguidas sin rotar (0 = no rotar nunca)
+        int distanciaMinima;  ///< Giro circular mínimo de cada rotación (1 a 13)
+        uint32_t semilla;     ///< Semilla para elegir entre giros de igual costo
+    };
+
+    /**
+     * @brief Constructor: política sin rotaciones y tramas simples
+     */
+    Encoder();
+
+    /**
+     * @brief Define la política de rotación
+     * @param nueva Política a aplicar desde la siguiente letra
+     */
+    void definirPolitica(const PoliticaRotacion& nueva);
+
+    /**
+     * @brief Emite tramas verificadas "#<secuencia>,<TIPO>,<DATO>*<CRC>"
+     * @param activo true para el formato con secuencia y CRC-32C
+     */
+    void habilitarVerificacion(bool activo);
+
+    /**
+     * @brief Usa "L,Space" (como el sketch original) en lugar de "L, "
+     * @param activo true para la forma compatible, 4 bytes más larga
+     */
+    void usarEspacioCompatible(bool activo);
+
+    /**
+     * @brief Codifica un bloque de texto y agrega las tramas a salida
+     * @param texto Texto plano
+     * @param longitud Cantidad de bytes de texto
+     * @param salida Cadena a la que se agregan las tramas (terminadas en '\n')
+     * @return Número de caracteres codificados
+     *
+     * Puede llamarse varias veces: el estado del rotor continúa entre llamadas.
+     * Los caracteres que el protocolo no puede transportar (CR, LF, '\0', ','
+     * y, en modo verificado, '#') se omiten y se cuentan en omitidos().
+     */
+    std::size_t codificar(const char* texto, std::size_t longitud, std::string& salida);
+
+    /**
+     * @brief Caracteres omitidos por no ser representables
+     * @return Total acumulado
+     */
+    unsigned long omitidos() const { return totalOmitidos; }
+
+    /**
+     * @brief Tramas MAP emitidas
+     * @return Total acumulado
+     */
+    unsigned long rotaciones() const { return totalRotaciones; }
+
+    /**
+     * @brief Tramas emitidas (LOAD + MAP)
+     * @return Total acumulado
+     */
+    unsigned long tramas() const { return totalTramas; }
+
+private:
+    /**
+     * @brief Calcula los giros de texto más corto que cumplen la política
+     */
+    void planificarGiros();
+
+    /**
+     * @brief Elige el siguiente giro entre los de costo mínimo
+     * @return Giro a emitir (positivo o negativo)
+     */
+    int elegirGiro();
+
+    /**
+     * @brief Agrega una trama con el formato configurado
+     * @param tipo 'L' o 'M'
+     * @param dato Texto del dato
+     * @param longitudDato Bytes de dato
+     * @param salida Cadena destino
+     */
+    void emitir(char tipo, const char* dato, std::size_t longitudDato, std::string& salida);
+
+    PoliticaRotacion politica;  ///< Política vigente
+    int giros[26];              ///< Giros de costo mínimo permitidos por la política
+    int cantidadGiros;          ///< Elementos válidos en giros
+    uint32_t estadoAleatorio;   ///< Estado del generador xorshift32
+    int desplazamiento;         ///< Rotación acumulada del rotor del receptor (0 a 25)
+    int cargasSinRotar;         ///< Letras emitidas desde la última rotación
+    bool verificacion;          ///< true para tramas con secuencia y CRC
+    bool espacioCompatible;     ///< true para "L,Space"
+    uint32_t secuencia;         ///< Siguiente número de secuencia
+    unsigned long totalOmitidos;    ///< Caracteres no representables
+    unsigned long totalRotaciones;  ///< Tramas MAP emitidas
+    unsigned long totalTramas;      ///< Tramas emitidas
+};
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file Enmarcador.h
+ * @brief Separador de tramas PRT-7 a partir de bloques de bytes
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ENMARCADOR_H
+#define ENMARCADOR_H
+
+#include <cstddef>
+
+/**
+ * @class Enmarcador
+ * @brief Acumula bytes y entrega cada trama completa terminada en CR o LF
+ *
+ * Reproduce las reglas de SerialPort::leerLinea(): las líneas vacías se
+ * ignoran y los caracteres que excedan el buffer se descartan. Conserva la
+ * línea parcial entre llamadas, por lo que acepta bloques de cualquier tamaño.
+ *
+ * Opcionalmente reconoce un marcador de inicio de trama: si aparece a mitad
+ * de una línea (por ejemplo, porque se corrompió el CR/LF anterior), la
+ * línea parcial se entrega tal cual y la nueva trama comienza en el marcador.
+ */
+class Enmarcador
+{
+public:
+    static const int LONGITUD_MAXIMA_TRAMA = 100;  ///< Tamaño del buffer de línea (incluye '\0')
+
+    /**
+     * @brief Constructor por defecto
+     */
+    Enmarcador() : indice(0), inicioTrama('\0') {
+        linea[0] = '\0';
+    }
+
+    /**
+     * @brief Define el marcador de inicio de trama usado para resincronizar
+     * @param marcador Carácter de inicio (por ejemplo '#'), o '\0' para desactivarlo
+     */
+    void definirInicioTrama(char marcador) {
+        inicioTrama = marcador;
+    }
+
+    /**
+     * @brief Agrega un bloque de bytes y entrega las tramas completadas
+     * @param datos Bytes recibidos
+     * @param longitud Cantidad de bytes en datos
+     * @param alCompletarTrama Invocable con firma void(const char* trama)
+     * @return Número de tramas entregadas
+     *
+     * La trama entregada sólo es válida durante la llamada a alCompletarTrama.
+     */
+    template <typename Funcion>
+    std::size_t agregar(const char* datos, std::size_t longitud, Funcion alCompletarTrama) {
+        std::size_t completadas = 0;
+
+        for (std::size_t i = 0; i < longitud; i++) {
+            char caracter = datos[i];
+
+            if (caracter == '\n' || caracter == '\r') {
+                // Ignorar líneas vacías (p. ej. el LF que sigue a un CR)
+                if (indice > 0) {
+                    linea[indice] = '\0';
+                    indice = 0;
+                    alCompletarTrama(static_cast<const char*>(linea));
+                    completadas++;
+                }
+                continue;
+            }
+
+            // Resincronizar: un marcador a mitad de línea cierra la trama anterior
+            if (caracter == inicioTrama && inicioTrama != '\0' && indice > 0) {
+                linea[indice] = '\0';
+                indice = 0;
+                alCompletarTrama(static_cast<const char*>(linea));
+                completadas++;
+            }
+
+            if (indice < LONGITUD_MAXIMA_TRAMA - 1) {
+                linea[indice++] = caracter;
+            }
+        }
+
+        return completadas;
+    }
+
+    /**
+     * @brief Descarta la línea parcial pendiente
+     */
+    void descartar() {
+        indice = 0;
+        linea[0] = '\0';
+    }
+
+private:
+    char linea[LONGITUD_MAXIMA_TRAMA];  ///< Línea parcial acumulada
+    int indice;                         ///< Posición de escritura en linea
+    char inicioTrama;                   ///< Marcador de inicio de trama ('\0' = sin marcador)
+};
+
+#endif
@@ -9,6 +9,8 @@
 #ifndef LISTADECARGA_H
 #define LISTADECARGA_H
 
+#include <atomic>
+#include <cstddef>
 #include <iostream>
 
 /**
@@ -18,7 +20,13 @@
  * Esta clase implementa una lista doblemente enlazada desde cero (sin STL)
  * que mantiene el orden de los caracteres decodificados del protocolo PRT-7.
  * 
+ * Admite un escritor y cualquier cantidad de lectores concurrentes: el
+ * escritor publica la longitud con orden release después de enlazar cada
+ * nodo, y los lectores la leen con acquire antes de recorrer. Los lectores
+ * nunca toman un candado ni escriben en la lista.
+ * 
  * @note Prohibido el uso de std::list o cualquier contenedor STL
+ * @warning vaciar() y el destructor no deben coincidir con lectores activos
  */
 class ListaDeCarga
 {
@@ -47,12 +55,16 @@ public:
 
     Nodo* cabeza;  ///< Puntero al primer nodo de la lista
     Nodo* cola;    ///< Puntero al último nodo de la lista
+    std::atomic<std::size_t> longitudPublicada;  ///< Nodos visibles para los lectores concurrentes
 
     /**
      * @brief Inserta un carácter al final de la lista
      * @param dato Carácter a insertar
      * 
      * Complejidad: O(1) gracias al puntero cola
+     * 
+     * El nodo queda completamente enlazado antes de publicar la nueva
+     * longitud, por lo que un lector concurrente nunca ve un nodo a medias.
      */
     void insertarAlFinal(char dato){
         Nodo* nuevo = new Nodo(dato);
@@ -65,6 +77,46 @@ public:
             nuevo->ant = cola;
             cola = nuevo;
         }
+        
+        // Sólo el escritor modifica la longitud: basta una carga relajada
+        longitudPublicada.store(longitudPublicada.load(std::memory_order_relaxed) + 1,
+                                std::memory_order_release);
+    }
+
+    /**
+     * @brief Copia una instantánea consistente del mensaje sin bloquear al escritor
+     * @param destino Buffer donde se copian los caracteres (no se agrega '\0')
+     * @param capacidad Tamaño del buffer
+     * @return Cantidad de caracteres copiados
+     * 
+     * Puede llamarse desde otro hilo mientras se ejecuta insertarAlFinal().
+     * Sólo recorre los nodos publicados: los punteros 'sig' que lee fueron
+     * escritos antes de la publicación y el escritor ya no los modifica.
+     * 
+     * Complejidad: O(n)
+     */
+    std::size_t copiarInstantanea(char* destino, std::size_t capacidad) const {
+        std::size_t visibles = longitudPublicada.load(std::memory_order_acquire);
+        if (visibles > capacidad) {
+            visibles = capacidad;
+        }
+        
+        const Nodo* actual = (visibles > 0) ? cabeza : nullptr;
+        for (std::size_t i = 0; i < visibles; i++) {
+            destino[i] = actual->dato;
+            if (i + 1 < visibles) {
+                actual = actual->sig;
+            }
+        }
+        return visibles;
+    }
+
+    /**
+     * @brief Cantidad de caracteres publicados
+     * @return Longitud visible para los lectores concurrentes
+     */
+    std::size_t longitud() const {
+        return longitudPublicada.load(std::memory_order_acquire);
     }
 
     /**
@@ -88,12 +140,31 @@ public:
         imprimirMensaje(Lista->sig);
     }
 
+    /**
+     * @brief Elimina todos los nodos y deja la lista vacía
+     * 
+     * Permite reutilizar la misma lista para ensamblar un nuevo mensaje.
+     * Complejidad: O(n)
+     */
+    void vaciar(){
+        longitudPublicada.store(0, std::memory_order_release);
+        
+        Nodo* actual = cabeza;
+        while (actual != nullptr) {
+            Nodo* siguiente = actual->sig;
+            delete actual;
+            actual = siguiente;
+        }
+        cabeza = nullptr;
+        cola = nullptr;
+    }
+
     /**
      * @brief Constructor por defecto
      * 
      * Inicializa la lista vacía con cabeza y cola en nullptr.
      */
-    ListaDeCarga(){
+    ListaDeCarga() : longitudPublicada(0) {
         cabeza = nullptr;
         cola = nullptr;
     }
@@ -101,17 +172,11 @@ public:
     /**
      * @brief Destructor
      * 
-     * Libera toda la memoria dinámica utilizada por los nodos de la lista.
-     * Recorre la lista y elimina cada nodo para evitar fugas de memoria.
+     * Libera toda la memoria dinámica utilizada por los nodos de la lista
+     * mediante vaciar() para evitar fugas de memoria.
      */
     ~ListaDeCarga() {
-        Nodo* actual = cabeza;
-        while (actual != nullptr) {
-            Nodo* siguiente = actual->sig;
-            delete actual;
-            actual = siguiente;
-        }
-        std::cout << "[ListaDeCarga] Destruida.... Sistema Apagado" << std::endl;
+        vaciar();
     }
 };
 
@@ -0,0 +1,269 @@
+/**
+ * @file Reactor.h
+ * @brief Reactor epoll de un solo hilo para corrutinas C++20
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ *
+ * @note Requiere C++20 (corrutinas). Sólo lo utiliza el ejecutable decodificador_async.
+ */
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <unordered_map>
+
+class Reactor;
+
+/**
+ * @class Tarea
+ * @brief Corrutina "lanzar y olvidar" ejecutada por un Reactor
+ *
+ * La tarea se crea suspendida y comienza a ejecutarse cuando se entrega a
+ * Reactor::lanzar(). Al terminar, su marco se libera automáticamente y el
+ * reactor descuenta la tarea de las tareas vivas.
+ */
+class Tarea
+{
+public:
+    /**
+     * @struct promise_type
+     * @brief Promesa requerida por el compilador para las corrutinas Tarea
+     */
+    struct promise_type
+    {
+        Reactor* reactor = nullptr;  ///< Reactor que ejecuta la tarea (asignado en lanzar())
+
+        Tarea get_return_object() {
+            return Tarea(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        /**
+         * @struct Finalizar
+         * @brief Libera el marco y avisa al reactor al terminar la corrutina
+         */
+        struct Finalizar
+        {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> h) noexcept;
+            void await_resume() noexcept {}
+        };
+
+        Finalizar final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Tarea(std::coroutine_handle<promise_type> h) : manejador(h) {}
+
+    std::coroutine_handle<promise_type> manejador;  ///< Corrutina aún no iniciada
+};
+
+/**
+ * @class Reactor
+ * @brief Bucle de eventos epoll que intercala esperas de E/S con trabajo de decodificación
+ *
+ * Mantiene una cola de corrutinas listas para continuar. Cuando la cola se
+ * vacía, bloquea en epoll_wait() hasta que algún descriptor tenga datos.
+ * Todas las corrutinas corren en el hilo que llama a ejecutar(), por lo que
+ * muchos flujos independientes comparten un solo hilo sin bloqueos.
+ */
+class Reactor
+{
+public:
+    /**
+     * @brief Constructor: crea la instancia epoll
+     */
+    Reactor() : descriptorEpoll(epoll_create1(EPOLL_CLOEXEC)), tareasVivas(0), esperasPendientes(0) {
+        if (descriptorEpoll < 0) {
+            std::cerr << "[ERROR] No se pudo crear epoll: " << strerror(errno) << std::endl;
+        }
+    }
+
+    /**
+     * @brief Destructor: cierra la instancia epoll
+     */
+    ~Reactor() {
+        if (descriptorEpoll >= 0) {
+            close(descriptorEpoll);
+        }
+    }
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /**
+     * @brief Entrega una tarea al reactor para que comience en el siguiente ciclo
+     * @param tarea Corrutina recién creada
+     */
+    void lanzar(Tarea tarea) {
+        tarea.manejador.promise().reactor = this;
+        tareasVivas++;
+        programar(tarea.manejador);
+    }
+
+    /**
+     * @brief Encola una corrutina suspendida para reanudarla
+     * @param h Corrutina a reanudar
+     */
+    void programar(std::coroutine_handle<> h) {
+        listas.push_back(h);
+    }
+
+    /**
+     * @struct EsperaLectura
+     * @brief Awaitable que suspende la corrutina hasta que el descriptor sea legible
+     */
+    struct EsperaLectura
+    {
+        Reactor& reactor;  ///< Reactor donde se registra la espera
+        int descriptor;    ///< Descriptor a vigilar
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) { reactor.registrar(descriptor, h); }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Crea un awaitable de lectura sobre un descriptor
+     * @param descriptor Descriptor en modo no bloqueante
+     * @return Awaitable para usar con co_await
+     */
+    EsperaLectura esperarLectura(int descriptor) {
+        return EsperaLectura{*this, descriptor};
+    }
+
+    /**
+     * @brief Ejecuta el bucle de eventos hasta que terminen todas las tareas
+     *
+     * Si quedan tareas vivas pero ninguna espera E/S ni está lista, el bucle
+     * termina para evitar un bloqueo permanente (tareas esperando un canal
+     * que nunca recibirá datos).
+     */
+    void ejecutar() {
+        epoll_event eventos[32];
+
+        while (tareasVivas > 0) {
+            while (!listas.empty()) {
+                std::coroutine_handle<> h = listas.front();
+                listas.pop_front();
+                h.resume();
+            }
+
+            if (tareasVivas == 0 || esperasPendientes == 0) {
+                break;
+            }
+
+            int n = epoll_wait(descriptorEpoll, eventos, 32, -1);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "[ERROR] epoll_wait: " << strerror(errno) << std::endl;
+                break;
+            }
+
+            for (int i = 0; i < n; i++) {
+                despertar(eventos[i].data.fd);
+            }
+        }
+    }
+
+private:
+    friend struct Tarea::promise_type::Finalizar;
+
+    /**
+     * @brief Registra una espera de lectura de un solo disparo (EPOLLONESHOT)
+     * @param descriptor Descriptor a vigilar
+     * @param h Corrutina a reanudar cuando el descriptor sea legible
+     *
+     * epoll guarda un solo registro por descriptor: si otra corrutina ya espera
+     * en él, la nueva se encola detrás y se atiende en el siguiente disparo en
+     * lugar de reemplazar a la anterior.
+     */
+    void registrar(int descriptor, std::coroutine_handle<> h) {
+        std::deque<std::coroutine_handle<>>& cola = esperas[descriptor];
+        cola.push_back(h);
+        esperasPendientes++;
+
+        if (cola.size() == 1 && !armar(descriptor)) {
+            // Reanudar de inmediato: la lectura reportará el error real
+            cola.clear();
+            esperasPendientes--;
+            programar(h);
+        }
+    }
+
+    /**
+     * @brief Arma (o re-arma) el disparo único de lectura de un descriptor
+     * @param descriptor Descriptor a vigilar
+     * @return false si epoll_ctl falló
+     */
+    bool armar(int descriptor) {
+        epoll_event evento;
+        evento.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        evento.data.fd = descriptor;
+
+        // Re-armar si ya estaba registrado; agregarlo en la primera espera
+        if (epoll_ctl(descriptorEpoll, EPOLL_CTL_MOD, descriptor, &evento) < 0) {
+            if (errno != ENOENT || epoll_ctl(descriptorEpoll, EPOLL_CTL_ADD, descriptor, &evento) < 0) {
+                std::cerr << "[ERROR] epoll_ctl: " << strerror(errno) << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reanuda la primera corrutina que espera en un descriptor legible
+     * @param descriptor Descriptor reportado por epoll_wait()
+     *
+     * Si quedan otras corrutinas en espera sobre el mismo descriptor, lo
+     * vuelve a armar para ellas.
+     */
+    void despertar(int descriptor) {
+        std::unordered_map<int, std::deque<std::coroutine_handle<>>>::iterator it = esperas.find(descriptor);
+        if (it == esperas.end() || it->second.empty()) {
+            return;
+        }
+
+        std::coroutine_handle<> h = it->second.front();
+        it->second.pop_front();
+        esperasPendientes--;
+        programar(h);
+
+        if (!it->second.empty() && !armar(descriptor)) {
+            while (!it->second.empty()) {
+                esperasPendientes--;
+                programar(it->second.front());
+                it->second.pop_front();
+            }
+        }
+    }
+
+    int descriptorEpoll;                        ///< Instancia epoll
+    std::deque<std::coroutine_handle<>> listas; ///< Corrutinas listas para continuar
+    int tareasVivas;                            ///< Tareas lanzadas que no han terminado
+    int esperasPendientes;                      ///< Corrutinas esperando E/S
+    std::unordered_map<int, std::deque<std::coroutine_handle<>>> esperas;  ///< Corrutinas en espera por descriptor
+};
+
+inline void Tarea::promise_type::Finalizar::await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+    Reactor* reactor = h.promise().reactor;
+    h.destroy();
+    if (reactor != nullptr) {
+        reactor->tareasVivas--;
+    }
+}
+
+#endif
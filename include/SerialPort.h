@@ -16,7 +16,11 @@
 #include <unistd.h>
 #include <termios.h>
 #include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <poll.h>
 #include <sys/ioctl.h>
+#include "Traza.h"
 
 /**
  * @class SerialPort
@@ -30,34 +34,23 @@ class SerialPort {
 private:
     int descriptorArchivo;  ///< Descriptor del archivo de puerto
     bool estadoConexion;    ///< Estado actual de la conexion
+    std::string ruta;       ///< Ruta del ultimo puerto abierto (para reconectar)
+    int baudios;            ///< Velocidad del ultimo puerto abierto
+    GrabadorTraza* captura; ///< Grabador de bytes recibidos (nullptr = sin captura)
     
-public:
     /**
-     * @brief Constructor por defecto
+     * @brief Abre y configura el puerto sin mostrar mensajes
+     * @return true si el descriptor quedo configurado
      * 
-     * Inicializa el puerto serial en estado cerrado.
-     */
-    SerialPort() : descriptorArchivo(-1), estadoConexion(false) {}
-    
-    /**
-     * @brief Establece conexion con puerto serial
-     * @param rutaPuerto Direccion del dispositivo (ejemplo: /dev/ttyACM0)
-     * @param velocidad Tasa de transmision en baudios (predeterminado 9600)
-     * @return true si la conexion fue exitosa, false en caso contrario
-     * 
-     * Configura el puerto serial con los parametros especificados:
+     * Configura el puerto serial con los parametros guardados en ruta y baudios:
      * - Velocidad de transmision (9600, 19200, 38400, 57600, 115200 bps)
      * - Formato 8N1 (8 bits de datos, sin paridad, 1 bit de parada)
      * - Modo sin procesar (raw mode)
      */
-    bool abrir(const std::string& rutaPuerto, int velocidad = 9600) {
-        descriptorArchivo = open(rutaPuerto.c_str(), O_RDONLY | O_NOCTTY);
+    bool configurarDescriptor() {
+        descriptorArchivo = open(ruta.c_str(), O_RDONLY | O_NOCTTY);
         
         if (descriptorArchivo < 0) {
-            std::cerr << "[ERROR] Imposible establecer conexion con " << rutaPuerto << std::endl;
-            std::cerr << "Verificaciones requeridas:" << std::endl;
-            std::cerr << "  1. Confirmar conexion fisica del dispositivo" << std::endl;
-            std::cerr << "  2. Otorgar permisos necesarios (sudo chmod 666 " << rutaPuerto << ")" << std::endl;
             return false;
         }
         
@@ -67,7 +60,7 @@ public:
         
         // Asignar velocidad de transmision
         speed_t tasaBaudios;
-        switch(velocidad) {
+        switch(baudios) {
             case 9600:  tasaBaudios = B9600;  break;
             case 19200: tasaBaudios = B19200; break;
             case 38400: tasaBaudios = B38400; break;
@@ -99,15 +92,90 @@ public:
         tcflush(descriptorArchivo, TCIOFLUSH);
         
         estadoConexion = true;
+        return true;
+    }
+    
+    /**
+     * @brief Cierra el descriptor tras detectar que el dispositivo desaparecio
+     * 
+     * Conserva ruta y baudios para que reconectar() pueda reabrir el puerto.
+     */
+    void marcarDesconectado() {
+        if (descriptorArchivo >= 0) {
+            close(descriptorArchivo);
+        }
+        descriptorArchivo = -1;
+        estadoConexion = false;
+        std::cerr << "[ADVERTENCIA] Dispositivo desconectado de " << ruta << std::endl;
+    }
+    
+public:
+    /**
+     * @brief Constructor por defecto
+     * 
+     * Inicializa el puerto serial en estado cerrado.
+     */
+    SerialPort() : descriptorArchivo(-1), estadoConexion(false), baudios(9600), captura(nullptr) {}
+    
+    /**
+     * @brief Establece conexion con puerto serial
+     * @param rutaPuerto Direccion del dispositivo (ejemplo: /dev/ttyACM0)
+     * @param velocidad Tasa de transmision en baudios (predeterminado 9600)
+     * @return true si la conexion fue exitosa, false en caso contrario
+     * 
+     * No espera un periodo fijo de estabilizacion: el llamador decide cuando
+     * el dispositivo esta listo (por ejemplo, al recibir la primera trama valida).
+     */
+    bool abrir(const std::string& rutaPuerto, int velocidad = 9600) {
+        ruta = rutaPuerto;
+        baudios = velocidad;
+        
+        if (!configurarDescriptor()) {
+            std::cerr << "[ERROR] Imposible establecer conexion con " << rutaPuerto << std::endl;
+            std::cerr << "Verificaciones requeridas:" << std::endl;
+            std::cerr << "  1. Confirmar conexion fisica del dispositivo" << std::endl;
+            std::cerr << "  2. Otorgar permisos necesarios (sudo chmod 666 " << rutaPuerto << ")" << std::endl;
+            return false;
+        }
+        
         std::cout << "[OK] Puerto " << rutaPuerto << " habilitado a " 
                   << velocidad << " baudios" << std::endl;
         
-        // Periodo de estabilizacion del dispositivo
-        sleep(2);
-        
         return true;
     }
     
+    /**
+     * @brief Reabre el ultimo puerto tras una desconexion
+     * @param tiempoMaximoMs Tiempo total maximo de reintentos en milisegundos
+     * @return true si el puerto se reabrio antes del limite
+     * 
+     * Reintenta con espera exponencial (50 ms, 100 ms, ... hasta 2 s) para
+     * no saturar el sistema mientras el adaptador USB vuelve a enumerarse.
+     */
+    bool reconectar(int tiempoMaximoMs = 30000) {
+        cerrar();
+        
+        std::chrono::steady_clock::time_point limite =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(tiempoMaximoMs);
+        int esperaMs = 50;
+        
+        std::cout << "[INFO] Reintentando conexion con " << ruta << "..." << std::endl;
+        while (true) {
+            if (configurarDescriptor()) {
+                std::cout << "[OK] Puerto " << ruta << " reconectado" << std::endl;
+                return true;
+            }
+            
+            if (std::chrono::steady_clock::now() + std::chrono::milliseconds(esperaMs) > limite) {
+                std::cerr << "[ERROR] No se pudo reconectar con " << ruta << std::endl;
+                return false;
+            }
+            
+            usleep(esperaMs * 1000);
+            esperaMs = (esperaMs * 2 > 2000) ? 2000 : esperaMs * 2;
+        }
+    }
+    
     /**
      * @brief Captura una secuencia de caracteres del puerto
      * @param secuencia Contenedor para almacenar la cadena recibida (buffer)
@@ -141,6 +209,10 @@ public:
                 continue;
             }
             
+            if (captura != nullptr) {
+                captura->registrar(&caracter, 1);
+            }
+            
             if (caracter == '\n' || caracter == '\r') {
                 if (indice > 0) {
                     secuencia[indice] = '\0';
@@ -155,6 +227,67 @@ public:
         }
     }
     
+    /**
+     * @brief Captura un bloque de bytes tal como llega del puerto
+     * @param destino Buffer donde se copian los bytes recibidos
+     * @param maximo Capacidad del buffer en bytes
+     * @param timeoutMs Espera maxima en milisegundos (-1 = sin limite)
+     * @return Bytes leidos (mayor que 0), 0 si vencio el tiempo, o -1 si hubo
+     *         un error o el dispositivo se desconecto
+     * 
+     * A diferencia de leerLinea(), no interpreta terminadores de linea:
+     * el bloque puede contener tramas parciales o varias tramas. Pensado
+     * para alimentar directamente a Decoder::feed().
+     * 
+     * Si el dispositivo desaparece (cuelgue o EIO) el puerto queda cerrado
+     * y estaAbierto() devuelve false; use reconectar() para recuperarlo.
+     */
+    ssize_t leerBytes(char* destino, size_t maximo, int timeoutMs = -1) {
+        if (!estadoConexion || descriptorArchivo < 0) {
+            return -1;
+        }
+        
+        struct pollfd espera;
+        espera.fd = descriptorArchivo;
+        espera.events = POLLIN;
+        espera.revents = 0;
+        
+        int listos = poll(&espera, 1, timeoutMs);
+        if (listos < 0) {
+            if (errno == EINTR) {
+                return 0;
+            }
+            std::cerr << "[ERROR] Fallo en lectura de puerto serial" << std::endl;
+            return -1;
+        }
+        
+        if (listos == 0) {
+            return 0;
+        }
+        
+        if ((espera.revents & POLLIN) == 0) {
+            // POLLHUP, POLLERR o POLLNVAL sin datos pendientes
+            marcarDesconectado();
+            return -1;
+        }
+        
+        ssize_t bytesCapturados = read(descriptorArchivo, destino, maximo);
+        if (bytesCapturados > 0) {
+            if (captura != nullptr) {
+                captura->registrar(destino, static_cast<size_t>(bytesCapturados));
+            }
+            return bytesCapturados;
+        }
+        
+        if (bytesCapturados < 0 && (errno == EAGAIN || errno == EINTR)) {
+            return 0;
+        }
+        
+        // Legible pero sin datos (fin de archivo) o EIO/ENXIO: el dispositivo se fue
+        marcarDesconectado();
+        return -1;
+    }
+    
     /**
      * @brief Consulta estado de la conexion
      * @return true si el puerto esta abierto, false en caso contrario
@@ -163,8 +296,34 @@ public:
         return estadoConexion;
     }
     
+    /**
+     * @brief Conecta (o desconecta) la captura de bytes recibidos
+     * @param grabador Grabador abierto, o nullptr para dejar de capturar
+     * 
+     * Cada bloque que entregan leerBytes() y leerLinea() se registra tal
+     * como llego, incluidos los CR/LF, con su marca de tiempo. El grabador
+     * no es propiedad del puerto y debe vivir mientras este conectado.
+     */
+    void definirCaptura(GrabadorTraza* grabador) {
+        captura = grabador;
+    }
+    
+    /**
+     * @brief Obtiene el descriptor del puerto
+     * @return Descriptor de archivo, o -1 si el puerto esta cerrado
+     * 
+     * Permite registrar el puerto en un reactor (epoll) para lecturas asincronas.
+     */
+    int descriptor() const {
+        return descriptorArchivo;
+    }
+    
     /**
      * @brief Reinicia el ESP32/Arduino mediante DTR
+     * 
+     * Genera un pulso corto en DTR (basta con el flanco para disparar el
+     * reinicio) y descarta lo recibido hasta ese momento. No espera a que el
+     * dispositivo arranque: eso lo determina la llegada de la primera trama.
      */
     void reiniciarDispositivo() {
         if (!estadoConexion || descriptorArchivo < 0) {
@@ -176,15 +335,13 @@ public:
         
         int estado = TIOCM_DTR;
         ioctl(descriptorArchivo, TIOCMBIC, &estado);
-        usleep(100000);
+        usleep(20000);
         
         ioctl(descriptorArchivo, TIOCMBIS, &estado);
-        usleep(100000);
         
         tcflush(descriptorArchivo, TCIOFLUSH);
         
-        std::cout << "[OK] Dispositivo reiniciado. Esperando estabilizacion..." << std::endl;
-        sleep(2);
+        std::cout << "[OK] Dispositivo reiniciado. Esperando primera trama..." << std::endl;
     }
     
     /**
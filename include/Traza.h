@@ -0,0 +1,168 @@
+/**
+ * @file Traza.h
+ * @brief Captura binaria con marcas de tiempo de los bytes recibidos y su reproducción
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ *
+ * Formato del archivo:
+ * - Cabecera: "PRT7TRZ1" (8 bytes)
+ * - Registros: varint(delta_ns) varint(longitud) bytes[longitud]
+ *
+ * delta_ns es la diferencia, en nanosegundos de reloj monótono, con el
+ * registro anterior (con el inicio de la captura para el primero). Los
+ * varint usan codificación LEB128 (7 bits por byte), de modo que un registro
+ * típico añade sólo 4 o 5 bytes de cabecera.
+ */
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class GrabadorTraza
+ * @brief Graba bloques de bytes con marca de tiempo mediante un hilo escritor en segundo plano
+ *
+ * registrar() sólo toma la marca de tiempo y copia el bloque a un buffer en
+ * memoria; el hilo escritor intercambia buffers y los escribe en disco por
+ * lotes. Si el disco no da abasto y el buffer supera su límite, los bloques
+ * nuevos se descartan (y se cuentan) en lugar de frenar la lectura.
+ */
+class GrabadorTraza
+{
+public:
+    static const std::size_t LIMITE_BUFFER = 16 * 1024 * 1024;  ///< Máximo en memoria antes de descartar (y tamaño máximo de un registro)
+
+    /**
+     * @brief Constructor: grabador cerrado
+     */
+    GrabadorTraza();
+
+    /**
+     * @brief Destructor: vacía los buffers pendientes y cierra el archivo
+     */
+    ~GrabadorTraza();
+
+    /**
+     * @brief Crea el archivo de traza e inicia el hilo escritor
+     * @param ruta Ruta del archivo a crear
+     * @return true si el archivo se creó correctamente
+     */
+    bool abrir(const std::string& ruta);
+
+    /**
+     * @brief Registra un bloque recibido con la marca de tiempo actual
+     * @param datos Bytes recibidos
+     * @param longitud Cantidad de bytes
+     *
+     * Diseñado para la ruta de lectura: no realiza llamadas de E/S.
+     */
+    void registrar(const char* datos, std::size_t longitud);
+
+    /**
+     * @brief Escribe lo pendiente, detiene el hilo escritor y cierra el archivo
+     */
+    void cerrar();
+
+    /**
+     * @brief Consulta si la grabación está activa
+     * @return true entre abrir() y cerrar()
+     */
+    bool estaAbierto() const { return archivo != nullptr; }
+
+    /**
+     * @brief Bloques que no llegaron al archivo
+     * @return Total acumulado de bloques descartados por desbordamiento del
+     *         buffer o perdidos por un error de escritura (disco lleno, etc.)
+     */
+    unsigned long descartados() const { return totalDescartados.load(); }
+
+private:
+    static const std::size_t UMBRAL_ESCRITURA = 64 * 1024;  ///< Despertar al escritor a partir de este tamaño
+
+    /**
+     * @brief Bucle del hilo escritor
+     */
+    void escribirEnSegundoPlano();
+
+    std::FILE* archivo;               ///< Archivo de traza
+    std::thread escritor;             ///< Hilo escritor
+    std::mutex candado;               ///< Protege pendiente, registrosPendientes, detener y ultimoNs
+    std::condition_variable aviso;    ///< Despierta al escritor
+    std::vector<char> pendiente;      ///< Registros aún no escritos
+    unsigned long registrosPendientes;  ///< Registros contenidos en pendiente
+    bool detener;                     ///< Solicitud de fin al escritor
+    uint64_t ultimoNs;                ///< Marca de tiempo del registro anterior
+    int errorEscritura;               ///< errno del primer fallo de escritura (0 = ninguno)
+    std::atomic<unsigned long> totalDescartados;  ///< Bloques que no llegaron al archivo
+
+    GrabadorTraza(const GrabadorTraza&);             ///< No copiable
+    GrabadorTraza& operator=(const GrabadorTraza&);  ///< No asignable
+};
+
+/**
+ * @class LectorTraza
+ * @brief Lee una traza grabada y la reproduce a velocidad original o máxima
+ */
+class LectorTraza
+{
+public:
+    /**
+     * @brief Constructor: lector cerrado
+     */
+    LectorTraza();
+
+    /**
+     * @brief Destructor: cierra el archivo
+     */
+    ~LectorTraza();
+
+    /**
+     * @brief Abre una traza y valida su cabecera
+     * @param ruta Ruta del archivo de traza
+     * @return true si el archivo existe y tiene formato válido
+     */
+    bool abrir(const std::string& ruta);
+
+    /**
+     * @brief Lee el siguiente registro
+     * @param tiempoNs Tiempo del registro desde el inicio de la captura
+     * @param datos Bytes del registro (se reemplaza el contenido)
+     * @return true si se leyó un registro; false al final del archivo, si está
+     *         truncado o si declara una longitud mayor que GrabadorTraza::LIMITE_BUFFER
+     */
+    bool siguiente(uint64_t& tiempoNs, std::vector<char>& datos);
+
+    /**
+     * @brief Entrega todos los registros restantes a un destino
+     * @param destino Función que recibe cada bloque (por ejemplo, Decoder::feed)
+     * @param velocidadOriginal true para respetar los tiempos grabados; false para ir lo más rápido posible
+     * @return Número de registros reproducidos
+     */
+    unsigned long reproducir(const std::function<void(const char*, std::size_t)>& destino,
+                             bool velocidadOriginal);
+
+    /**
+     * @brief Cierra el archivo
+     */
+    void cerrar();
+
+private:
+    std::FILE* archivo;  ///< Archivo de traza
+    uint64_t tiempoNs;   ///< Tiempo acumulado del último registro leído
+
+    LectorTraza(const LectorTraza&);             ///< No copiable
+    LectorTraza& operator=(const LectorTraza&);  ///< No asignable
+};
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file AlertasPalabras.cpp
+ * @brief Implementación del detector Aho-Corasick de la biblioteca prt7
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#include "AlertasPalabras.h"
+
+#include <fstream>
+
+AlertasPalabras::AlertasPalabras() : construido(false), estado(0), posicion(0) {
+    construir();
+}
+
+unsigned char AlertasPalabras::normalizar(char caracter) {
+    unsigned char c = static_cast<unsigned char>(caracter);
+    if (c >= 'a' && c <= 'z') {
+        c = static_cast<unsigned char>(c - 'a' + 'A');
+    }
+    return c;
+}
+
+void AlertasPalabras::agregarPalabra(const std::string& palabra) {
+    if (palabra.empty()) {
+        return;
+    }
+    palabras.push_back(palabra);
+    construido = false;
+}
+
+bool AlertasPalabras::cargarArchivo(const std::string& ruta) {
+    std::ifstream archivo(ruta.c_str());
+    if (!archivo) {
+        return false;
+    }
+
+    std::string linea;
+    while (std::getline(archivo, linea)) {
+        // Tolerar archivos con fin de línea CRLF
+        if (!linea.empty() && linea[linea.size() - 1] == '\r') {
+            linea.erase(linea.size() - 1);
+        }
+        if (linea.empty() || linea[0] == '#') {
+            continue;
+        }
+        agregarPalabra(linea);
+    }
+
+    construir();
+    return !palabras.empty();
+}
+
+/**
+ * 1. Inserta cada palabra en un trie (transiciones = -1 donde no hay hijo)
+ * 2. Recorre el trie por niveles: el fallo de un hijo es la transición del
+ *    fallo del padre; las transiciones ausentes se copian del fallo, lo que
+ *    convierte el trie en un autómata completo
+ * 3. enlaceSalida apunta al sufijo propio más largo que es una palabra
+ */
+void AlertasPalabras::construir() {
+    transiciones.assign(ALFABETO, -1);
+    palabraFinal.assign(1, -1);
+
+    for (std::size_t p = 0; p < palabras.size(); p++) {
+        int actual = 0;
+        for (std::size_t i = 0; i < palabras[p].size(); i++) {
+            unsigned char c = normalizar(palabras[p][i]);
+            int siguiente = transiciones[actual * ALFABETO + c];
+            if (siguiente < 0) {
+                siguiente = static_cast<int>(palabraFinal.size());
+                transiciones.resize(transiciones.size() + ALFABETO, -1);
+                palabraFinal.push_back(-1);
+                transiciones[actual * ALFABETO + c] = siguiente;
+            }
+            actual = siguiente;
+        }
+        // Con palabras repetidas se conserva la primera
+        if (palabraFinal[actual] < 0) {
+            palabraFinal[actual] = static_cast<int>(p);
+        }
+    }
+
+    std::size_t estados = palabraFinal.size();
+    fallo.assign(estados, 0);
+    enlaceSalida.assign(estados, -1);
+
+    std::vector<int> cola;
+    cola.reserve(estados);
+
+    for (int c = 0; c < ALFABETO; c++) {
+        int hijo = transiciones[c];
+        if (hijo < 0) {
+            transiciones[c] = 0;
+        } else {
+            fallo[hijo] = 0;
+            cola.push_back(hijo);
+        }
+    }
+
+    for (std::size_t frente = 0; frente < cola.size(); frente++) {
+        int actual = cola[frente];
+        int sufijo = fallo[actual];
+        enlaceSalida[actual] = (palabraFinal[sufijo] >= 0) ? sufijo : enlaceSalida[sufijo];
+
+        for (int c = 0; c < ALFABETO; c++) {
+            int hijo = transiciones[actual * ALFABETO + c];
+            if (hijo < 0) {
+                transiciones[actual * ALFABETO + c] = transiciones[sufijo * ALFABETO + c];
+            } else {
+                fallo[hijo] = transiciones[sufijo * ALFABETO + c];
+                cola.push_back(hijo);
+            }
+        }
+    }
+
+    construido = true;
+    reiniciar();
+}
+
+void AlertasPalabras::avanzar(char caracter) {
+    if (!construido) {
+        construir();
+    }
+
+    estado = transiciones[estado * ALFABETO + normalizar(caracter)];
+    posicion++;
+
+    if (!alDetectar) {
+        return;
+    }
+
+    int coincidencia = (palabraFinal[estado] >= 0) ? estado : enlaceSalida[estado];
+    while (coincidencia >= 0) {
+        const std::string& palabra = palabras[palabraFinal[coincidencia]];
+        alDetectar(palabra.c_str(), posicion - palabra.size(), posicion);
+        coincidencia = enlaceSalida[coincidencia];
+    }
+}
+
+void AlertasPalabras::reiniciar() {
+    estado = 0;
+    posicion = 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file Crc32c.cpp
+ * @brief Implementación de CRC-32C con aceleración por hardware cuando existe
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#include "Crc32c.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define PRT7_CRC32C_X86 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define PRT7_CRC32C_ARM 1
+#endif
+
+namespace {
+
+typedef uint32_t (*FuncionCrc)(uint32_t, const unsigned char*, std::size_t);
+
+/**
+ * @brief Tabla para el cálculo por software (polinomio reflejado 0x82F63B78)
+ */
+struct TablaCrc32c
+{
+    uint32_t valores[256];
+
+    TablaCrc32c() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : (crc >> 1);
+            }
+            valores[i] = crc;
+        }
+    }
+};
+
+uint32_t crc32cSoftware(uint32_t crc, const unsigned char* p, std::size_t n) {
+    static const TablaCrc32c tabla;
+    for (std::size_t i = 0; i < n; i++) {
+        crc = tabla.valores[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(PRT7_CRC32C_X86)
+__attribute__((target("sse4.2")))
+uint32_t crc32cHardware(uint32_t crc, const unsigned char* p, std::size_t n) {
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    while (n >= 8) {
+        uint64_t bloque;
+        memcpy(&bloque, p, 8);
+        crc64 = _mm_crc32_u64(crc64, bloque);
+        p += 8;
+        n -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    while (n > 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+        n--;
+    }
+    return crc;
+}
+#elif defined(PRT7_CRC32C_ARM)
+uint32_t crc32cHardware(uint32_t crc, const unsigned char* p, std::size_t n) {
+    while (n >= 8) {
+        uint64_t bloque;
+        memcpy(&bloque, p, 8);
+        crc = __crc32cd(crc, bloque);
+        p += 8;
+        n -= 8;
+    }
+    while (n > 0) {
+        crc = __crc32cb(crc, *p++);
+        n--;
+    }
+    return crc;
+}
+#endif
+
+bool detectarHardware() {
+#if defined(PRT7_CRC32C_X86)
+    return __builtin_cpu_supports("sse4.2");
+#elif defined(PRT7_CRC32C_ARM)
+    return true;
+#else
+    return false;
+#endif
+}
+
+FuncionCrc seleccionarImplementacion() {
+#if defined(PRT7_CRC32C_X86) || defined(PRT7_CRC32C_ARM)
+    if (detectarHardware()) {
+        return crc32cHardware;
+    }
+#endif
+    return crc32cSoftware;
+}
+
+} // namespace
+
+uint32_t crc32c(const char* datos, std::size_t longitud) {
+    static const FuncionCrc implementacion = seleccionarImplementacion();
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(datos);
+    return implementacion(0xFFFFFFFFu, p, longitud) ^ 0xFFFFFFFFu;
+}
+
+bool crc32cAcelerado() {
+    return detectarHardware();
+}
@@ -0,0 +1,251 @@
+/**
+ * @file Decoder.cpp
+ * @brief Implementación del decodificador PRT-7 de la biblioteca prt7
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#include "Decoder.h"
+
+#include <cstdlib>
+#include <cstring>
+#include "Crc32c.h"
+#include "TramaBase.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+
+Decoder::Decoder()
+    : totalTramas(0), totalAplicadas(0), verificacion(false), haySecuencia(false), ultimaSecuencia(0) {
+    contadores.validas = 0;
+    contadores.corruptas = 0;
+    contadores.perdidas = 0;
+    contadores.duplicadas = 0;
+}
+
+std::size_t Decoder::feed(const char* datos, std::size_t longitud) {
+    return enmarcador.agregar(datos, longitud, [this](const char* trama) {
+        procesarTrama(trama);
+    });
+}
+
+void Decoder::finalizarMensaje() {
+    if (alFinalizarMensaje) {
+        alFinalizarMensaje(listaCarga);
+    }
+    listaCarga.vaciar();
+}
+
+void Decoder::habilitarVerificacion(bool activo) {
+    verificacion = activo;
+    enmarcador.definirInicioTrama(inicioTrama());
+}
+
+void Decoder::descartarParcial() {
+    enmarcador.descartar();
+}
+
+void Decoder::procesarTrama(const char* trama) {
+    totalTramas++;
+    if (alRecibirTrama) {
+        alRecibirTrama(trama);
+    }
+
+    if (!verificacion) {
+        interpretarTrama(trama, trama);
+        return;
+    }
+
+    char carga[LONGITUD_MAXIMA_TRAMA];
+    uint32_t secuencia;
+    if (!validarTrama(trama, carga, secuencia)) {
+        contadores.corruptas++;
+        if (alRechazarTrama) {
+            alRechazarTrama(trama, "Trama corrupta");
+        }
+        return;
+    }
+
+    if (!aceptarSecuencia(secuencia)) {
+        contadores.duplicadas++;
+        if (alRechazarTrama) {
+            alRechazarTrama(trama, "Trama duplicada");
+        }
+        return;
+    }
+
+    contadores.validas++;
+    interpretarTrama(trama, carga);
+}
+
+/**
+ * Formato: "#<secuencia>,<TIPO>,<DATO>*<CRC>"
+ * 1. Localiza el último '*' y exige exactamente 8 dígitos hexadecimales
+ * 2. Compara el CRC-32C de lo que hay entre '#' y '*'
+ * 3. Sólo con el CRC correcto confía en la secuencia y la extrae
+ */
+bool Decoder::validarTrama(const char* trama, char* carga, uint32_t& secuencia) {
+    if (trama[0] != '#') {
+        return false;
+    }
+
+    const char* asterisco = strrchr(trama, '*');
+    if (asterisco == nullptr || strlen(asterisco + 1) != 8) {
+        return false;
+    }
+
+    uint32_t crcRecibido = 0;
+    for (int i = 1; i <= 8; i++) {
+        char c = asterisco[i];
+        uint32_t digito;
+        if (c >= '0' && c <= '9') {
+            digito = c - '0';
+        } else if (c >= 'A' && c <= 'F') {
+            digito = c - 'A' + 10;
+        } else if (c >= 'a' && c <= 'f') {
+            digito = c - 'a' + 10;
+        } else {
+            return false;
+        }
+        crcRecibido = (crcRecibido << 4) | digito;
+    }
+
+    const char* contenido = trama + 1;
+    std::size_t longitudContenido = static_cast<std::size_t>(asterisco - contenido);
+    if (crc32c(contenido, longitudContenido) != crcRecibido) {
+        return false;
+    }
+
+    // Secuencia decimal seguida de ','
+    secuencia = 0;
+    std::size_t i = 0;
+    while (i < longitudContenido && contenido[i] >= '0' && contenido[i] <= '9') {
+        secuencia = secuencia * 10 + static_cast<uint32_t>(contenido[i] - '0');
+        i++;
+    }
+    if (i == 0 || i >= longitudContenido || contenido[i] != ',') {
+        return false;
+    }
+
+    std::size_t longitudCarga = longitudContenido - i - 1;
+    memcpy(carga, contenido + i + 1, longitudCarga);
+    carga[longitudCarga] = '\0';
+    return true;
+}
+
+/**
+ * Con diferencia modular respecto de la secuencia esperada:
+ * - Hacia adelante: se acepta y el salto se cuenta como pérdidas
+ * - Igual a la anterior (incluida una repetición de #0): siempre se rechaza para
+ *   no aplicar dos veces la misma trama (un MAP repetido giraría el rotor dos veces)
+ * - Hasta VENTANA_REPETICION atrás: retransmisión, se rechaza
+ * - Vuelta a 0 desde otra secuencia o salto mayor hacia atrás: el emisor se
+ *   reinició, se acepta
+ */
+bool Decoder::aceptarSecuencia(uint32_t secuencia) {
+    if (haySecuencia) {
+        if (secuencia == ultimaSecuencia) {
+            return false;
+        }
+
+        uint32_t hueco = secuencia - (ultimaSecuencia + 1);
+        if (hueco < 0x80000000u) {
+            contadores.perdidas += hueco;
+        } else {
+            uint32_t retroceso = ultimaSecuencia - secuencia;
+            if (secuencia != 0 && retroceso <= VENTANA_REPETICION) {
+                return false;
+            }
+        }
+    }
+
+    ultimaSecuencia = secuencia;
+    haySecuencia = true;
+    return true;
+}
+
+/**
+ * Funcionamiento:
+ * 1. Valida que la trama tenga formato correcto
+ * 2. Separa el comando (L/M) del dato
+ * 3. Crea dinámicamente el objeto Trama correspondiente (polimorfismo)
+ * 4. Ejecuta el procesamiento llamando a trama->procesar()
+ * 5. Libera la memoria del objeto creado
+ */
+void Decoder::interpretarTrama(const char* trama, const char* lineas) {
+    // Buscar el separador ','
+    int posicionComa = -1;
+    int longitud = 0;
+
+    for (int i = 0; lineas[i] != '\0'; i++) {
+        if (lineas[i] == ',') {
+            posicionComa = i;
+        }
+        longitud++;
+    }
+
+    // Validar formato de trama
+    if (posicionComa == -1 || posicionComa == 0 || posicionComa == longitud - 1) {
+        if (alRechazarTrama) {
+            alRechazarTrama(trama, "Formato de trama invalido");
+        }
+        return;
+    }
+
+    // Extraer comando y dato
+    char comando = lineas[0];
+    const char* dato = &lineas[posicionComa + 1];
+
+    // Interpretar según el tipo de comando (polimorfismo)
+    switch (comando) {
+        case 'L':
+        case 'l':
+            {
+                // Trama LOAD: cargar un carácter
+                char letra;
+                if (strcmp(dato, "Space") == 0 || strcmp(dato, "space") == 0) {
+                    letra = ' ';
+                } else {
+                    letra = dato[0];
+                }
+
+                TramaBase* tramaLoad = new TramaLoad(letra);
+                tramaLoad->procesar(&listaCarga, &rotorMapeo);
+                delete tramaLoad;
+                totalAplicadas++;
+
+                if (alDecodificar) {
+                    alDecodificar(listaCarga.cola->dato);
+                }
+            }
+            break;
+
+        case 'M':
+        case 'm':
+            {
+                // Trama MAP: rotar el rotor. Se exige un entero completo para
+                // que un byte corrupto no se convierta en una rotación falsa.
+                char* fin = nullptr;
+                long movimiento = strtol(dato, &fin, 10);
+                if (fin == dato || *fin != '\0') {
+                    if (alRechazarTrama) {
+                        alRechazarTrama(trama, "Rotacion invalida");
+                    }
+                    return;
+                }
+
+                // El rotor tiene 26 posiciones: reducir evita recorridos largos
+                TramaBase* tramaMap = new TramaMap(static_cast<int>(movimiento % 26));
+                tramaMap->procesar(&listaCarga, &rotorMapeo);
+                delete tramaMap;
+                totalAplicadas++;
+            }
+            break;
+
+        default:
+            if (alRechazarTrama) {
+                alRechazarTrama(trama, "Comando desconocido");
+            }
+            break;
+    }
+}
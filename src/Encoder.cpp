@@ -0,0 +1,188 @@
+/**
+ * @file Encoder.cpp
+ * @brief Implementación del codificador PRT-7 de la biblioteca prt7
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#include "Encoder.h"
+
+#include "Crc32c.h"
+
+namespace {
+
+/**
+ * @brief Escribe un entero con signo en base 10
+ * @param valor Entero a escribir
+ * @param destino Buffer de al menos 12 bytes
+ * @return Cantidad de caracteres escritos (sin '\0')
+ */
+std::size_t escribirEntero(long valor, char* destino) {
+    char invertido[12];
+    std::size_t n = 0;
+    unsigned long magnitud = (valor < 0) ? static_cast<unsigned long>(-valor) : static_cast<unsigned long>(valor);
+
+    do {
+        invertido[n++] = static_cast<char>('0' + magnitud % 10);
+        magnitud /= 10;
+    } while (magnitud > 0);
+
+    std::size_t escritos = 0;
+    if (valor < 0) {
+        destino[escritos++] = '-';
+    }
+    while (n > 0) {
+        destino[escritos++] = invertido[--n];
+    }
+    return escritos;
+}
+
+} // namespace
+
+Encoder::Encoder()
+    : cantidadGiros(0), estadoAleatorio(1), desplazamiento(0), cargasSinRotar(0),
+      verificacion(false), espacioCompatible(false), secuencia(0),
+      totalOmitidos(0), totalRotaciones(0), totalTramas(0) {
+    PoliticaRotacion inicial;
+    inicial.maximoCargas = 0;
+    inicial.distanciaMinima = 1;
+    inicial.semilla = 1;
+    definirPolitica(inicial);
+}
+
+void Encoder::definirPolitica(const PoliticaRotacion& nueva) {
+    politica = nueva;
+    if (politica.distanciaMinima < 1) {
+        politica.distanciaMinima = 1;
+    }
+    if (politica.distanciaMinima > 13) {
+        politica.distanciaMinima = 13;
+    }
+    // xorshift32 no admite estado cero
+    estadoAleatorio = (politica.semilla != 0) ? politica.semilla : 0x9E3779B9u;
+    planificarGiros();
+}
+
+void Encoder::habilitarVerificacion(bool activo) {
+    verificacion = activo;
+}
+
+void Encoder::usarEspacioCompatible(bool activo) {
+    espacioCompatible = activo;
+}
+
+/**
+ * Recorre todos los giros representables (-25..25) y conserva los que
+ * alcanzan la distancia mínima con el menor número de caracteres.
+ */
+void Encoder::planificarGiros() {
+    std::size_t mejorAncho = 0;
+    cantidadGiros = 0;
+
+    for (int giro = -25; giro <= 25; giro++) {
+        int modulo = ((giro % 26) + 26) % 26;
+        int distancia = (modulo < 26 - modulo) ? modulo : 26 - modulo;
+        if (distancia < politica.distanciaMinima) {
+            continue;
+        }
+
+        char texto[12];
+        std::size_t ancho = escribirEntero(giro, texto);
+        if (cantidadGiros == 0 || ancho < mejorAncho) {
+            mejorAncho = ancho;
+            cantidadGiros = 0;
+        }
+        if (ancho == mejorAncho) {
+            giros[cantidadGiros++] = giro;
+        }
+    }
+}
+
+int Encoder::elegirGiro() {
+    estadoAleatorio ^= estadoAleatorio << 13;
+    estadoAleatorio ^= estadoAleatorio >> 17;
+    estadoAleatorio ^= estadoAleatorio << 5;
+    return giros[estadoAleatorio % static_cast<uint32_t>(cantidadGiros)];
+}
+
+void Encoder::emitir(char tipo, const char* dato, std::size_t longitudDato, std::string& salida) {
+    totalTramas++;
+
+    if (!verificacion) {
+        salida += tipo;
+        salida += ',';
+        salida.append(dato, longitudDato);
+        salida += '\n';
+        return;
+    }
+
+    // "#<secuencia>,<TIPO>,<DATO>*<CRC>": el CRC cubre lo que hay entre '#' y '*'
+    std::size_t inicio = salida.size();
+    salida += '#';
+    char numero[12];
+    salida.append(numero, escribirEntero(static_cast<long>(secuencia++), numero));
+    salida += ',';
+    salida += tipo;
+    salida += ',';
+    salida.append(dato, longitudDato);
+
+    uint32_t crc = crc32c(salida.data() + inicio + 1, salida.size() - inicio - 1);
+    static const char hexadecimal[] = "0123456789ABCDEF";
+    char sufijo[10];
+    sufijo[0] = '*';
+    for (int i = 0; i < 8; i++) {
+        sufijo[1 + i] = hexadecimal[(crc >> (28 - 4 * i)) & 0xF];
+    }
+    sufijo[9] = '\n';
+    salida.append(sufijo, sizeof(sufijo));
+}
+
+std::size_t Encoder::codificar(const char* texto, std::size_t longitud, std::string& salida) {
+    std::size_t codificados = 0;
+
+    for (std::size_t i = 0; i < longitud; i++) {
+        char caracter = texto[i];
+
+        if (caracter == '\r' || caracter == '\n' || caracter == '\0' || caracter == ','
+            || (verificacion && caracter == '#')) {
+            totalOmitidos++;
+            continue;
+        }
+
+        if (caracter == ' ') {
+            if (espacioCompatible) {
+                emitir('L', "Space", 5, salida);
+            } else {
+                emitir('L', " ", 1, salida);
+            }
+            codificados++;
+            continue;
+        }
+
+        if (caracter < 'A' || caracter > 'Z') {
+            // El rotor no transforma este carácter: se envía sin cambios
+            emitir('L', &caracter, 1, salida);
+            codificados++;
+            continue;
+        }
+
+        // Rotar sólo cuando la política lo exige, justo antes de esta letra
+        if (politica.maximoCargas > 0 && cargasSinRotar >= politica.maximoCargas) {
+            int giro = elegirGiro();
+            char numero[12];
+            emitir('M', numero, escribirEntero(giro, numero), salida);
+            desplazamiento = (((desplazamiento + giro) % 26) + 26) % 26;
+            cargasSinRotar = 0;
+            totalRotaciones++;
+        }
+
+        // Inversa de getMapeo: el receptor sumará 'desplazamiento'
+        char enviada = static_cast<char>('A' + ((caracter - 'A') - desplazamiento + 26) % 26);
+        emitir('L', &enviada, 1, salida);
+        cargasSinRotar++;
+        codificados++;
+    }
+
+    return codificados;
+}
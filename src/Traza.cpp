@@ -0,0 +1,284 @@
+/**
+ * @file Traza.cpp
+ * @brief Implementación de la captura y reproducción de trazas de la biblioteca prt7
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ */
+
+#include "Traza.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <time.h>
+
+namespace {
+
+const char MAGICO_TRAZA[8] = {'P', 'R', 'T', '7', 'T', 'R', 'Z', '1'};
+
+/**
+ * @brief Reloj monótono en nanosegundos
+ * @return Tiempo de CLOCK_MONOTONIC
+ */
+uint64_t ahoraNs() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return static_cast<uint64_t>(t.tv_sec) * 1000000000ull + static_cast<uint64_t>(t.tv_nsec);
+}
+
+/**
+ * @brief Agrega un entero sin signo en formato LEB128
+ * @param valor Entero a codificar
+ * @param destino Buffer destino
+ */
+void agregarVarint(uint64_t valor, std::vector<char>& destino) {
+    while (valor >= 0x80) {
+        destino.push_back(static_cast<char>((valor & 0x7F) | 0x80));
+        valor >>= 7;
+    }
+    destino.push_back(static_cast<char>(valor));
+}
+
+/**
+ * @brief Lee un entero LEB128 de un archivo
+ * @param archivo Archivo de origen
+ * @param valor Entero decodificado
+ * @return false si el archivo terminó o el varint es inválido
+ */
+bool leerVarint(std::FILE* archivo, uint64_t& valor) {
+    valor = 0;
+    for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+        int byte = std::fgetc(archivo);
+        if (byte == EOF) {
+            return false;
+        }
+        valor |= static_cast<uint64_t>(byte & 0x7F) << desplazamiento;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+GrabadorTraza::GrabadorTraza()
+    : archivo(nullptr), registrosPendientes(0), detener(false), ultimoNs(0), errorEscritura(0),
+      totalDescartados(0) {
+}
+
+GrabadorTraza::~GrabadorTraza() {
+    cerrar();
+}
+
+bool GrabadorTraza::abrir(const std::string& ruta) {
+    cerrar();
+
+    archivo = std::fopen(ruta.c_str(), "wb");
+    if (archivo == nullptr) {
+        std::cerr << "[ERROR] No se pudo crear la traza " << ruta << std::endl;
+        return false;
+    }
+    if (std::fwrite(MAGICO_TRAZA, 1, sizeof(MAGICO_TRAZA), archivo) != sizeof(MAGICO_TRAZA)
+        || std::fflush(archivo) != 0) {
+        std::cerr << "[ERROR] No se pudo escribir la traza " << ruta << ": " << strerror(errno) << std::endl;
+        std::fclose(archivo);
+        archivo = nullptr;
+        return false;
+    }
+
+    pendiente.clear();
+    pendiente.reserve(UMBRAL_ESCRITURA * 2);
+    registrosPendientes = 0;
+    detener = false;
+    ultimoNs = ahoraNs();
+    errorEscritura = 0;
+    totalDescartados = 0;
+    escritor = std::thread(&GrabadorTraza::escribirEnSegundoPlano, this);
+
+    std::cout << "[OK] Capturando bytes recibidos en " << ruta << std::endl;
+    return true;
+}
+
+void GrabadorTraza::registrar(const char* datos, std::size_t longitud) {
+    if (archivo == nullptr || longitud == 0) {
+        return;
+    }
+
+    uint64_t marca = ahoraNs();
+    bool despertar = false;
+    {
+        std::lock_guard<std::mutex> guardia(candado);
+        if (pendiente.size() + longitud + 20 > LIMITE_BUFFER) {
+            totalDescartados++;
+            return;
+        }
+
+        uint64_t delta = (marca > ultimoNs) ? marca - ultimoNs : 0;
+        ultimoNs += delta;
+        agregarVarint(delta, pendiente);
+        agregarVarint(longitud, pendiente);
+        pendiente.insert(pendiente.end(), datos, datos + longitud);
+        registrosPendientes++;
+        despertar = pendiente.size() >= UMBRAL_ESCRITURA;
+    }
+
+    if (despertar) {
+        aviso.notify_one();
+    }
+}
+
+/**
+ * Intercambia el buffer pendiente por uno vacío bajo el candado y escribe
+ * fuera de él, de modo que registrar() nunca espera al disco. Sin tráfico
+ * suficiente para alcanzar el umbral, vacía el buffer cada 100 ms.
+ *
+ * Tras el primer fallo de escritura deja de escribir: el archivo conserva un
+ * prefijo legible (a lo sumo con un último registro truncado) y todo lo que
+ * sigue se cuenta en descartados().
+ */
+void GrabadorTraza::escribirEnSegundoPlano() {
+    std::vector<char> lote;
+    lote.reserve(UMBRAL_ESCRITURA * 2);
+
+    while (true) {
+        bool terminar;
+        unsigned long registrosLote;
+        {
+            std::unique_lock<std::mutex> guardia(candado);
+            aviso.wait_for(guardia, std::chrono::milliseconds(100), [this] {
+                return detener || pendiente.size() >= UMBRAL_ESCRITURA;
+            });
+            lote.swap(pendiente);
+            registrosLote = registrosPendientes;
+            registrosPendientes = 0;
+            terminar = detener;
+        }
+
+        if (!lote.empty()) {
+            errno = 0;
+            if (errorEscritura == 0
+                && (std::fwrite(lote.data(), 1, lote.size(), archivo) != lote.size()
+                    || std::fflush(archivo) != 0)) {
+                errorEscritura = (errno != 0) ? errno : EIO;
+                std::cerr << "[ERROR] Traza: fallo de escritura (" << strerror(errorEscritura)
+                          << "); se descarta el resto de la captura" << std::endl;
+            }
+            if (errorEscritura != 0) {
+                totalDescartados += registrosLote;
+            }
+            lote.clear();
+        }
+
+        if (terminar) {
+            return;
+        }
+    }
+}
+
+void GrabadorTraza::cerrar() {
+    if (archivo == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guardia(candado);
+        detener = true;
+    }
+    aviso.notify_one();
+    if (escritor.joinable()) {
+        escritor.join();
+    }
+
+    if (std::fclose(archivo) != 0 && errorEscritura == 0) {
+        std::cerr << "[ERROR] Traza: fallo al cerrar (" << strerror(errno) << ")" << std::endl;
+    }
+    archivo = nullptr;
+
+    if (totalDescartados > 0) {
+        std::cerr << "[ADVERTENCIA] Traza: " << totalDescartados << " bloques descartados" << std::endl;
+    }
+}
+
+LectorTraza::LectorTraza() : archivo(nullptr), tiempoNs(0) {
+}
+
+LectorTraza::~LectorTraza() {
+    cerrar();
+}
+
+bool LectorTraza::abrir(const std::string& ruta) {
+    cerrar();
+
+    archivo = std::fopen(ruta.c_str(), "rb");
+    if (archivo == nullptr) {
+        std::cerr << "[ERROR] No se pudo abrir la traza " << ruta << std::endl;
+        return false;
+    }
+
+    char magico[sizeof(MAGICO_TRAZA)];
+    if (std::fread(magico, 1, sizeof(magico), archivo) != sizeof(magico)
+        || memcmp(magico, MAGICO_TRAZA, sizeof(magico)) != 0) {
+        std::cerr << "[ERROR] Formato de traza desconocido en " << ruta << std::endl;
+        cerrar();
+        return false;
+    }
+
+    tiempoNs = 0;
+    return true;
+}
+
+bool LectorTraza::siguiente(uint64_t& tiempo, std::vector<char>& datos) {
+    if (archivo == nullptr) {
+        return false;
+    }
+
+    uint64_t delta;
+    uint64_t longitud;
+    if (!leerVarint(archivo, delta) || !leerVarint(archivo, longitud)) {
+        return false;
+    }
+
+    if (longitud > GrabadorTraza::LIMITE_BUFFER) {
+        // Ningún registro válido supera el buffer del grabador: archivo dañado
+        std::cerr << "[ERROR] Traza: registro con longitud invalida (" << longitud << " bytes)" << std::endl;
+        return false;
+    }
+
+    datos.resize(static_cast<std::size_t>(longitud));
+    if (longitud > 0 && std::fread(datos.data(), 1, datos.size(), archivo) != datos.size()) {
+        // Registro truncado (captura interrumpida)
+        return false;
+    }
+
+    tiempoNs += delta;
+    tiempo = tiempoNs;
+    return true;
+}
+
+unsigned long LectorTraza::reproducir(const std::function<void(const char*, std::size_t)>& destino,
+                                      bool velocidadOriginal) {
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    std::vector<char> datos;
+    uint64_t tiempo;
+    unsigned long registros = 0;
+
+    while (siguiente(tiempo, datos)) {
+        if (velocidadOriginal) {
+            std::this_thread::sleep_until(inicio + std::chrono::nanoseconds(tiempo));
+        }
+        destino(datos.data(), datos.size());
+        registros++;
+    }
+
+    return registros;
+}
+
+void LectorTraza::cerrar() {
+    if (archivo != nullptr) {
+        std::fclose(archivo);
+        archivo = nullptr;
+    }
+}
@@ -0,0 +1,166 @@
+/**
+ * @file codificador.cpp
+ * @brief Herramienta de línea de comandos para generar flujos PRT-7
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ *
+ * Convierte texto plano en tramas L/M con la clase Encoder. Sirve para
+ * producir flujos realistas para pruebas de carga y para el firmware.
+ *
+ * Uso:
+ *   codificador [opciones] [texto ...]     (sin texto: lee la entrada estándar)
+ *
+ * Opciones:
+ *   -n <N>                 rotar al menos cada N letras (0 = nunca, por defecto)
+ *   -d <D>                 giro circular mínimo de cada rotación (1 a 13)
+ *   -s <semilla>           semilla para elegir entre giros de igual costo
+ *   --verificado           tramas con secuencia y CRC-32C
+ *   --espacio-compatible   usar "L,Space" como el sketch original
+ *   --comprobar            decodificar el flujo generado y compararlo con el texto
+ *   --silencio             no escribir las tramas (útil para medir rendimiento)
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "Decoder.h"
+#include "Encoder.h"
+
+/**
+ * @brief Decodifica un flujo y lo compara con el texto esperado
+ * @param flujo Tramas generadas por el Encoder
+ * @param esperado Texto plano sin los caracteres omitidos
+ * @param verificado true si el flujo usa tramas verificadas
+ * @return true si el mensaje decodificado coincide exactamente
+ */
+bool comprobarIdaYVuelta(const std::string& flujo, const std::string& esperado, bool verificado);
+
+/**
+ * @brief Función principal del codificador
+ * @param argc Cantidad de argumentos
+ * @param argv Opciones y texto a codificar
+ * @return 0 si la codificación (y la comprobación, si se pidió) fue exitosa
+ */
+int main(int argc, char* argv[])
+{
+    Encoder::PoliticaRotacion politica;
+    politica.maximoCargas = 0;
+    politica.distanciaMinima = 1;
+    politica.semilla = 1;
+
+    bool verificado = false;
+    bool espacioCompatible = false;
+    bool comprobar = false;
+    bool silencio = false;
+    std::string texto;
+    bool hayTexto = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            politica.maximoCargas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            politica.distanciaMinima = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            politica.semilla = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--verificado") == 0) {
+            verificado = true;
+        } else if (strcmp(argv[i], "--espacio-compatible") == 0) {
+            espacioCompatible = true;
+        } else if (strcmp(argv[i], "--comprobar") == 0) {
+            comprobar = true;
+        } else if (strcmp(argv[i], "--silencio") == 0) {
+            silencio = true;
+        } else {
+            if (hayTexto) {
+                texto += ' ';
+            }
+            texto += argv[i];
+            hayTexto = true;
+        }
+    }
+
+    if (!hayTexto) {
+        char bloque[4096];
+        while (std::cin.read(bloque, sizeof(bloque)) || std::cin.gcount() > 0) {
+            texto.append(bloque, static_cast<std::size_t>(std::cin.gcount()));
+        }
+    }
+
+    Encoder codificador;
+    codificador.definirPolitica(politica);
+    codificador.habilitarVerificacion(verificado);
+    codificador.usarEspacioCompatible(espacioCompatible);
+
+    std::string flujo;
+    flujo.reserve(texto.size() * (verificado ? 20 : 4));
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    std::size_t codificados = codificador.codificar(texto.data(), texto.size(), flujo);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    if (!silencio) {
+        std::cout.write(flujo.data(), static_cast<std::streamsize>(flujo.size()));
+        std::cout.flush();
+    }
+
+    std::cerr << "[INFO] " << codificados << " caracteres -> " << codificador.tramas()
+              << " tramas (" << codificador.rotaciones() << " rotaciones), "
+              << flujo.size() << " bytes";
+    if (codificador.omitidos() > 0) {
+        std::cerr << ", " << codificador.omitidos() << " omitidos";
+    }
+    if (segundos > 0) {
+        std::cerr << ", " << static_cast<unsigned long>(codificados / segundos) << " caracteres/s";
+    }
+    std::cerr << std::endl;
+
+    if (comprobar) {
+        std::string esperado;
+        esperado.reserve(codificados);
+        for (std::size_t i = 0; i < texto.size(); i++) {
+            char c = texto[i];
+            if (c != '\r' && c != '\n' && c != '\0' && c != ',' && !(verificado && c == '#')) {
+                esperado += c;
+            }
+        }
+
+        if (!comprobarIdaYVuelta(flujo, esperado, verificado)) {
+            std::cerr << "[ERROR] El flujo decodificado no coincide con el texto" << std::endl;
+            return 1;
+        }
+        std::cerr << "[OK] Ida y vuelta verificada con Decoder" << std::endl;
+    }
+
+    return 0;
+}
+
+bool comprobarIdaYVuelta(const std::string& flujo, const std::string& esperado, bool verificado) {
+    Decoder decodificador;
+    decodificador.habilitarVerificacion(verificado);
+
+    std::string obtenido;
+    obtenido.reserve(esperado.size());
+    bool rechazos = false;
+
+    decodificador.alDecodificar = [&obtenido](char caracter) {
+        obtenido += caracter;
+    };
+    decodificador.alRechazarTrama = [&rechazos](const char* trama, const char* motivo) {
+        std::cerr << "[ERROR] " << motivo << ": " << trama << std::endl;
+        rechazos = true;
+    };
+
+    // Alimentar por bloques y liberar la lista de carga en cada uno: el rotor
+    // conserva su estado, así que el resultado es el mismo que en un solo mensaje
+    const std::size_t tamanoBloque = 1 << 16;
+    for (std::size_t i = 0; i < flujo.size(); i += tamanoBloque) {
+        std::size_t n = (flujo.size() - i < tamanoBloque) ? flujo.size() - i : tamanoBloque;
+        decodificador.feed(flujo.data() + i, n);
+        decodificador.finalizarMensaje();
+    }
+
+    return !rechazos && obtenido == esperado;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file lector_anillo.cpp
+ * @brief Consumidor de ejemplo del anillo en memoria compartida del Decodificador PRT-7
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ *
+ * Se conecta al segmento publicado por "decodificador --anillo <nombre>" y
+ * muestra cada mensaje al completarse. Sólo lee memoria: no realiza llamadas
+ * al sistema por evento y nunca frena al decodificador.
+ */
+
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include "AnilloCompartido.h"
+
+/**
+ * @brief Función principal del lector
+ * @param argc Cantidad de argumentos
+ * @param argv argv[1]: nombre del segmento (por defecto /prt7)
+ * @return 0 si la conexión fue exitosa, 1 en caso contrario
+ */
+int main(int argc, char* argv[])
+{
+    std::string nombre = (argc > 1) ? argv[1] : "/prt7";
+
+    LectorAnillo lector;
+    if (!lector.conectar(nombre, true)) {
+        return 1;
+    }
+    std::cout << "[OK] Leyendo anillo " << nombre << " (Ctrl+C para salir)" << std::endl;
+
+    std::string mensaje;
+    uint64_t perdidosReportados = 0;
+    uint64_t reiniciosReportados = 0;
+    EventoAnillo evento;
+
+    while (true) {
+        if (!lector.leer(evento)) {
+            // Sin datos nuevos: ceder la CPU brevemente
+            usleep(1000);
+            continue;
+        }
+
+        if (lector.reinicios() != reiniciosReportados) {
+            // El mensaje parcial pertenecía a la ejecución anterior del productor
+            std::cout << "[INFO] El decodificador se reinicio; descartando mensaje parcial" << std::endl;
+            reiniciosReportados = lector.reinicios();
+            mensaje.clear();
+        }
+
+        if (lector.perdidos() != perdidosReportados) {
+            std::cout << "[ADVERTENCIA] Eventos perdidos: "
+                      << lector.perdidos() - perdidosReportados << std::endl;
+            perdidosReportados = lector.perdidos();
+        }
+
+        if (evento.tipo == EventoAnillo::CARACTER) {
+            mensaje += evento.caracter;
+        } else if (evento.tipo == EventoAnillo::FIN_MENSAJE) {
+            std::cout << "Mensaje #" << evento.mensaje << ": " << mensaje << std::endl;
+            mensaje.clear();
+        }
+    }
+}
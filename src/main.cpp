@@ -4,151 +4,300 @@
  * @author Equipo de Desarrollo
  * @version 1.0
  * @date 2024
- * 
+ *
  * Este programa implementa un decodificador para el protocolo industrial PRT-7
  * que recibe tramas desde un dispositivo Arduino vía puerto serial.
+ * Toda la lógica de decodificación vive en la biblioteca prt7 (clase Decoder);
+ * este archivo sólo conecta el puerto serial con el decodificador y la consola.
  */
 
-#include <iostream>
+#include <atomic>
+#include <chrono>
 #include <cstring>
-#include "TramaBase.h"
-#include "ListaDeCarga.h"
-#include "RotorDeMapeo.h"
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "AlertasPalabras.h"
+#include "AnilloCompartido.h"
+#include "Crc32c.h"
+#include "Decoder.h"
 #include "SerialPort.h"
-#include "TramaLoad.h"
-#include "TramaMap.h"
+#include "Traza.h"
 
 /**
- * @brief Procesa una línea recibida del puerto serial
- * @param lineas Cadena con formato "X,Y" donde X es el comando (L/M) e Y es el dato
- * 
- * Esta función parsea la trama, crea el objeto polimórfico correspondiente
- * (TramaLoad o TramaMap), lo procesa y libera su memoria.
+ * @brief Conecta los callbacks del decodificador con la salida por consola
+ * @param decodificador Decodificador cuyos eventos se mostrarán
  */
-void cargarLineas(char*);
+void configurarSalida(Decoder& decodificador);
 
-// Estructuras de datos globales
-ListaDeCarga ListaCarga;  ///< Lista que almacena el mensaje decodificado
-RotorDeMapeo RotorMapeo;  ///< Rotor circular para el mapeo de caracteres
+/**
+ * @brief Espera a que el dispositivo envíe su primera trama válida
+ * @param puerto Puerto ya abierto
+ * @param decodificador Decodificador que recibe los bytes leídos
+ * @param tiempoMaximoMs Límite de espera en milisegundos
+ * @return true si llegó una trama válida antes del límite
+ *
+ * Sustituye a los periodos fijos de estabilización: el programa continúa en
+ * cuanto el dispositivo termina de arrancar. Las tramas recibidas durante la
+ * espera se procesan normalmente. Si el dispositivo se desconecta antes de
+ * la primera trama, el puerto se reconecta dentro del mismo límite.
+ */
+bool esperarPrimeraTrama(SerialPort& puerto, Decoder& decodificador, int tiempoMaximoMs);
+
+/**
+ * @brief Muestra periódicamente el mensaje parcial desde otro hilo
+ * @param mensaje Lista de carga que el hilo principal sigue ampliando
+ * @param activo Bandera que el hilo principal apaga para detener el monitor
+ *
+ * Usa ListaDeCarga::copiarInstantanea(), que no toma candados ni frena al escritor.
+ */
+void monitorearMensaje(const ListaDeCarga& mensaje, const std::atomic<bool>& activo);
 
 /**
  * @brief Función principal del programa
+ * @param argc Cantidad de argumentos
+ * @param argv Opciones: --verificado exige tramas con secuencia y CRC-32C;
+ *             --anillo <nombre> publica la salida en memoria compartida;
+ *             --puerto <ruta> cambia el dispositivo (por defecto /dev/ttyUSB0);
+ *             --monitor muestra el mensaje parcial mientras llegan tramas;
+ *             --alertas <archivo> avisa al decodificar palabras clave;
+ *             --capturar <archivo> graba los bytes recibidos con marcas de tiempo;
+ *             --reproducir <archivo> decodifica una captura en lugar del puerto
+ *             (a la velocidad original, o lo más rápido posible con --rapido)
  * @return 0 si la ejecución fue exitosa
- * 
+ *
  * Flujo del programa:
- * 1. Inicializa las estructuras de datos (ListaCarga vacía, RotorMapeo con A-Z)
+ * 1. Crea el decodificador (ListaDeCarga vacía, RotorDeMapeo con A-Z)
  * 2. Abre el puerto serial y reinicia el dispositivo Arduino
- * 3. Lee las tramas del puerto y las procesa una por una
+ * 3. Espera la primera trama válida y alimenta al decodificador con los
+ *    bloques recibidos, reconectando el puerto si el dispositivo se desconecta
  * 4. Imprime el mensaje decodificado final
  * 5. Libera memoria y cierra recursos
  */
-int main()
+int main(int argc, char* argv[])
 {
     // Crear instancia del puerto serial
     SerialPort puerto;
+    Decoder decodificador;
+    configurarSalida(decodificador);
+
+    bool verificado = false;
+    const char* nombreAnillo = nullptr;
+    const char* archivoAlertas = nullptr;
+    const char* rutaPuerto = "/dev/ttyUSB0";
+    const char* archivoCaptura = nullptr;
+    const char* archivoReproduccion = nullptr;
+    bool rapido = false;
+    bool monitor = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verificado") == 0) {
+            verificado = true;
+        } else if (strcmp(argv[i], "--anillo") == 0 && i + 1 < argc) {
+            nombreAnillo = argv[++i];
+        } else if (strcmp(argv[i], "--alertas") == 0 && i + 1 < argc) {
+            archivoAlertas = argv[++i];
+        } else if (strcmp(argv[i], "--puerto") == 0 && i + 1 < argc) {
+            rutaPuerto = argv[++i];
+        } else if (strcmp(argv[i], "--capturar") == 0 && i + 1 < argc) {
+            archivoCaptura = argv[++i];
+        } else if (strcmp(argv[i], "--reproducir") == 0 && i + 1 < argc) {
+            archivoReproduccion = argv[++i];
+        } else if (strcmp(argv[i], "--rapido") == 0) {
+            rapido = true;
+        } else if (strcmp(argv[i], "--monitor") == 0) {
+            monitor = true;
+        }
+    }
+    decodificador.habilitarVerificacion(verificado);
+
+    // Publicar también en memoria compartida para consumidores locales
+    AnilloCompartido anillo;
+    if (nombreAnillo != nullptr) {
+        anillo.crear(nombreAnillo);
+    }
+
+    // Detectar palabras clave a medida que se decodifica cada carácter
+    AlertasPalabras alertas;
+    bool hayAlertas = false;
+    if (archivoAlertas != nullptr) {
+        hayAlertas = alertas.cargarArchivo(archivoAlertas);
+        if (hayAlertas) {
+            std::cout << "[OK] " << alertas.cantidadPalabras() << " palabras clave cargadas" << std::endl;
+            alertas.alDetectar = [](const char* palabra, std::size_t inicio, std::size_t fin) {
+                std::cout << "[ALERTA] Palabra clave \"" << palabra << "\" en posiciones "
+                          << inicio << "-" << fin << std::endl;
+            };
+        } else {
+            std::cerr << "[ERROR] No se pudieron cargar palabras clave de " << archivoAlertas << std::endl;
+        }
+    }
+
+    if (anillo.estaAbierto() || hayAlertas) {
+        decodificador.alDecodificar = [&anillo, &alertas, hayAlertas](char caracter) {
+            anillo.publicarCaracter(caracter);
+            if (hayAlertas) {
+                alertas.avanzar(caracter);
+            }
+        };
+        std::function<void(ListaDeCarga&)> mostrarMensaje = decodificador.alFinalizarMensaje;
+        decodificador.alFinalizarMensaje = [&anillo, &alertas, mostrarMensaje](ListaDeCarga& mensaje) {
+            mostrarMensaje(mensaje);
+            anillo.publicarFinMensaje();
+            alertas.reiniciar();
+        };
+    }
+
     std::cout << "=== Decodificador  PRT-7 ===" << std::endl << std::endl;
-    
-    if (puerto.abrir("/dev/ttyUSB0", 9600)) {
+
+    // El monitor acompaña tanto la lectura del puerto como la reproducción
+    std::atomic<bool> monitorActivo(monitor);
+    std::thread hiloMonitor;
+    if (monitor) {
+        hiloMonitor = std::thread(monitorearMensaje, std::cref(decodificador.mensaje()),
+                                  std::cref(monitorActivo));
+    }
+
+    if (archivoReproduccion != nullptr) {
+        // Reproducir una captura previa: mismos bloques y tiempos que el puerto
+        LectorTraza traza;
+        if (traza.abrir(archivoReproduccion)) {
+            unsigned long bloques = traza.reproducir(
+                [&decodificador](const char* datos, std::size_t longitud) {
+                    decodificador.feed(datos, longitud);
+                }, !rapido);
+            std::cout << "[OK] " << bloques << " bloques reproducidos de " << archivoReproduccion << std::endl;
+        }
+    } else if (puerto.abrir(rutaPuerto, 9600)) {
         std::cout << "Esperando datos de Arduino..." << std::endl;
-        
+
+        // Grabar lo recibido para reproducir incidentes más tarde
+        GrabadorTraza captura;
+        if (archivoCaptura != nullptr && captura.abrir(archivoCaptura)) {
+            puerto.definirCaptura(&captura);
+        }
+
         // Reiniciar el ESP32 para que envíe datos desde el inicio
         puerto.reiniciarDispositivo();
-        
-        char lineas[100];
-        
-        // Leer tramas (ciclo completo del sketch)
-        for (int i = 0; i < 14; i++) {
-            if (puerto.leerLinea(lineas)) {
-                cargarLineas(lineas);
+
+        if (esperarPrimeraTrama(puerto, decodificador, 5000)) {
+            // Lo rechazado antes de la primera trama válida es ruido de arranque
+            unsigned long ruidoArranque = decodificador.tramasRecibidas() - decodificador.tramasAplicadas();
+            char bloque[64];
+
+            // Leer tramas (ciclo completo del sketch)
+            while (decodificador.tramasRecibidas() - ruidoArranque < 14) {
+                ssize_t leidos = puerto.leerBytes(bloque, sizeof(bloque));
+                if (leidos > 0) {
+                    decodificador.feed(bloque, static_cast<size_t>(leidos));
+                } else if (leidos < 0) {
+                    // Desconexión: la trama partida se descarta, el rotor se conserva
+                    decodificador.descartarParcial();
+                    if (!puerto.reconectar()) {
+                        break;
+                    }
+                }
             }
         }
+
+        puerto.definirCaptura(nullptr);
+        captura.cerrar();
         puerto.cerrar();
     }
 
+    // Detener el monitor antes de que finalizarMensaje() vacíe la lista
+    monitorActivo.store(false);
+    if (hiloMonitor.joinable()) {
+        hiloMonitor.join();
+    }
+
     // Mostrar el mensaje decodificado
-    std::cout << " --- " << std::endl;
-    std::cout << " MENSAJE OCULTO ENSAMBLADO " << std::endl;
-    ListaCarga.imprimirMensaje(ListaCarga.cabeza);
-    std::cout << std::endl;
-    std::cout << " --- " << std::endl;
+    decodificador.finalizarMensaje();
+
+    if (verificado) {
+        Decoder::EstadisticasTramas estadisticas = decodificador.estadisticas();
+        std::cout << "Tramas validas: " << estadisticas.validas
+                  << " | corruptas: " << estadisticas.corruptas
+                  << " | perdidas: " << estadisticas.perdidas
+                  << " | duplicadas: " << estadisticas.duplicadas
+                  << " (CRC-32C " << (crc32cAcelerado() ? "por hardware" : "por software") << ")"
+                  << std::endl;
+    }
+
+    // La biblioteca no imprime: el aviso de apagado es responsabilidad del programa
+    std::cout << "[ListaDeCarga] Destruida.... Sistema Apagado" << std::endl;
 
     return 0;
 }
 
-/**
- * @brief Procesa y parsea una línea recibida del puerto serial
- * @param lineas Buffer que contiene la trama recibida (formato: "X,Y")
- * 
- * Funcionamiento:
- * 1. Valida que la trama tenga formato correcto
- * 2. Separa el comando (L/M) del dato
- * 3. Crea dinámicamente el objeto Trama correspondiente (polimorfismo)
- * 4. Ejecuta el procesamiento llamando a trama->procesar()
- * 5. Libera la memoria del objeto creado
- * 
- * @note Usa gestión manual de memoria (new/delete) sin STL
- */
-void cargarLineas(char* lineas){
-    if (lineas == nullptr || lineas[0] == '\0') {
-        std::cout << "[ADVERTENCIA] Trama vacia recibida" << std::endl;
-        return;
-    }
+bool esperarPrimeraTrama(SerialPort& puerto, Decoder& decodificador, int tiempoMaximoMs) {
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point limite = inicio + std::chrono::milliseconds(tiempoMaximoMs);
+    char bloque[64];
 
-    std::cout << "Trama recibida: [" << lineas << "] -> Procesando...." << std::endl; 
-    
-    // Buscar el separador ','
-    int posicionComa = -1;
-    int longitud = 0;
-    
-    for (int i = 0; lineas[i] != '\0'; i++) {
-        if (lineas[i] == ',') {
-            posicionComa = i;
+    while (decodificador.tramasAplicadas() == 0) {
+        long restanteMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            limite - std::chrono::steady_clock::now()).count();
+        if (restanteMs <= 0) {
+            std::cerr << "[ERROR] El dispositivo no envio tramas validas en "
+                      << tiempoMaximoMs << " ms" << std::endl;
+            return false;
         }
-        longitud++;
-    }
-    
-    // Validar formato de trama
-    if (posicionComa == -1 || posicionComa == 0 || posicionComa == longitud - 1) {
-        std::cout << "[ERROR] Formato de trama invalido: " << lineas << std::endl;
-        return;
-    }
-    
-    // Extraer comando y dato
-    char comando = lineas[0];
-    const char* dato = &lineas[posicionComa + 1];
-    
-    // Interpretar según el tipo de comando (polimorfismo)
-    switch(comando) {
-        case 'L':
-        case 'l':
-            {
-                // Trama LOAD: cargar un carácter
-                char letra;
-                if (strcmp(dato, "Space") == 0 || strcmp(dato, "space") == 0) {
-                    letra = ' ';
-                } else {
-                    letra = dato[0];
-                }
-                
-                TramaBase* trama = new TramaLoad(letra);
-                trama->procesar(&ListaCarga, &RotorMapeo);
-                delete trama;
-            }
-            break;
-            
-        case 'M':
-        case 'm':
-            {
-                // Trama MAP: rotar el rotor
-                int movimiento = atoi(dato);
-                TramaBase* trama = new TramaMap(movimiento);
-                trama->procesar(&ListaCarga, &RotorMapeo);
-                delete trama;
+
+        ssize_t leidos = puerto.leerBytes(bloque, sizeof(bloque), static_cast<int>(restanteMs));
+        if (leidos < 0) {
+            // Desconexión durante el arranque: reintentar dentro del mismo límite
+            decodificador.descartarParcial();
+            if (!puerto.reconectar(static_cast<int>(restanteMs))) {
+                return false;
             }
-            break;
-            
-        default:
-            std::cout << "[DESCONOCIDO] Comando: " << comando << ", Dato: " << dato << std::endl;
-            break;
+            continue;
+        }
+        decodificador.feed(bloque, static_cast<size_t>(leidos));
+    }
+
+    long transcurridoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - inicio).count();
+    std::cout << "[OK] Dispositivo listo en " << transcurridoMs << " ms" << std::endl;
+    return true;
+}
+
+void monitorearMensaje(const ListaDeCarga& mensaje, const std::atomic<bool>& activo) {
+    std::vector<char> instantanea;
+    std::size_t mostrados = 0;
+
+    while (activo.load()) {
+        // El mensaje sólo crece mientras el monitor está activo: basta con
+        // ampliar el buffer hasta la longitud publicada
+        std::size_t visibles = mensaje.longitud();
+        if (visibles > instantanea.size()) {
+            instantanea.resize(visibles);
+        }
+
+        std::size_t copiados = mensaje.copiarInstantanea(instantanea.data(), instantanea.size());
+        if (copiados != mostrados) {
+            std::cout << "[MONITOR] Mensaje parcial: ";
+            std::cout.write(instantanea.data(), static_cast<std::streamsize>(copiados));
+            std::cout << std::endl;
+            mostrados = copiados;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
     }
 }
+
+void configurarSalida(Decoder& decodificador) {
+    decodificador.alRecibirTrama = [](const char* trama) {
+        std::cout << "Trama recibida: [" << trama << "] -> Procesando...." << std::endl;
+    };
+
+    decodificador.alRechazarTrama = [](const char* trama, const char* motivo) {
+        std::cout << "[ERROR] " << motivo << ": " << trama << std::endl;
+    };
+
+    decodificador.alFinalizarMensaje = [](ListaDeCarga& mensaje) {
+        std::cout << " --- " << std::endl;
+        std::cout << " MENSAJE OCULTO ENSAMBLADO " << std::endl;
+        mensaje.imprimirMensaje(mensaje.cabeza);
+        std::cout << std::endl;
+        std::cout << " --- " << std::endl;
+    };
+}
@@ -0,0 +1,303 @@
+/**
+ * @file main_async.cpp
+ * @brief Modo asíncrono del Decodificador PRT-7 basado en corrutinas C++20
+ * @author Equipo de Desarrollo
+ * @version 1.0
+ * @date 2024
+ *
+ * Cada flujo (puerto serial, o "-" para la entrada estándar) se procesa con
+ * una tubería de cuatro etapas conectadas por canales acotados:
+ *
+ *   lectura -> enmarcado -> decodificación -> salida
+ *
+ * Todas las etapas de todos los flujos corren en un único hilo sobre un
+ * Reactor epoll: mientras un puerto espera datos, el hilo decodifica los
+ * bytes ya recibidos de otros puertos.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "Canal.h"
+#include "Decoder.h"
+#include "Enmarcador.h"
+#include "Reactor.h"
+#include "SerialPort.h"
+
+/**
+ * @struct Bloque
+ * @brief Bytes crudos leídos del descriptor en una sola llamada a read()
+ */
+struct Bloque
+{
+    char datos[256];        ///< Bytes recibidos
+    std::size_t longitud;   ///< Bytes válidos en datos
+};
+
+/**
+ * @struct Linea
+ * @brief Trama completa sin terminador CR/LF
+ */
+struct Linea
+{
+    char texto[Enmarcador::LONGITUD_MAXIMA_TRAMA];  ///< Trama terminada en '\0'
+};
+
+/**
+ * @struct Evento
+ * @brief Resultado de la etapa de decodificación hacia la etapa de salida
+ */
+struct Evento
+{
+    enum Tipo { CARACTER, RECHAZO, FIN_MENSAJE };
+
+    Tipo tipo;                                      ///< Clase de evento
+    char caracter;                                  ///< Carácter decodificado (CARACTER)
+    char texto[Enmarcador::LONGITUD_MAXIMA_TRAMA];  ///< Trama descartada (RECHAZO)
+};
+
+/**
+ * @struct Flujo
+ * @brief Estado de un flujo independiente: origen, decodificador y canales entre etapas
+ */
+struct Flujo
+{
+    std::string ruta;                      ///< Nombre mostrado en la salida
+    int descriptor;                        ///< Descriptor no bloqueante de lectura
+    SerialPort puerto;                     ///< Puerto serial (sin usar para "-")
+    Decoder decodificador;                 ///< Decodificador propio del flujo
+    Enmarcador enmarcador;                 ///< Separador de tramas de la etapa de enmarcado
+    Canal<Bloque, 4> bytes;                ///< lectura -> enmarcado
+    Canal<Linea, 16> lineas;               ///< enmarcado -> decodificación
+    Canal<Evento, 64> eventos;             ///< decodificación -> salida
+    std::vector<Evento> eventosPendientes; ///< Eventos generados por los callbacks del decodificador
+    std::string mensaje;                   ///< Mensaje acumulado por la etapa de salida
+
+    explicit Flujo(Reactor& reactor)
+        : descriptor(-1), bytes(reactor), lineas(reactor), eventos(reactor) {}
+};
+
+/**
+ * @brief Etapa de lectura: espera en epoll y envía los bloques crudos
+ * @param reactor Reactor que ejecuta la etapa
+ * @param flujo Flujo a leer
+ */
+Tarea etapaLectura(Reactor& reactor, Flujo& flujo) {
+    while (true) {
+        Bloque bloque;
+        ssize_t leidos = read(flujo.descriptor, bloque.datos, sizeof(bloque.datos));
+
+        if (leidos > 0) {
+            bloque.longitud = static_cast<std::size_t>(leidos);
+            co_await flujo.bytes.enviar(bloque);
+            continue;
+        }
+
+        if (leidos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            co_await reactor.esperarLectura(flujo.descriptor);
+            continue;
+        }
+
+        if (leidos < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (leidos < 0) {
+            std::cerr << "[ERROR] Fallo en lectura de " << flujo.ruta << ": " << strerror(errno) << std::endl;
+        }
+        break;  // Fin de archivo o error
+    }
+
+    flujo.bytes.cerrar();
+}
+
+/**
+ * @brief Etapa de enmarcado: separa los bloques en tramas completas
+ * @param flujo Flujo a procesar
+ */
+Tarea etapaEnmarcado(Flujo& flujo) {
+    std::vector<Linea> completadas;
+
+    while (std::optional<Bloque> bloque = co_await flujo.bytes.recibir()) {
+        completadas.clear();
+        flujo.enmarcador.agregar(bloque->datos, bloque->longitud, [&completadas](const char* trama) {
+            Linea linea;
+            strncpy(linea.texto, trama, sizeof(linea.texto) - 1);
+            linea.texto[sizeof(linea.texto) - 1] = '\0';
+            completadas.push_back(linea);
+        });
+
+        for (const Linea& linea : completadas) {
+            co_await flujo.lineas.enviar(linea);
+        }
+    }
+
+    flujo.lineas.cerrar();
+}
+
+/**
+ * @brief Etapa de decodificación: aplica cada trama al rotor y la lista de carga
+ * @param flujo Flujo a procesar
+ *
+ * Al cerrarse el flujo se finaliza el mensaje en curso.
+ */
+Tarea etapaDecodificacion(Flujo& flujo) {
+    while (std::optional<Linea> linea = co_await flujo.lineas.recibir()) {
+        flujo.decodificador.procesarTrama(linea->texto);
+
+        for (const Evento& evento : flujo.eventosPendientes) {
+            co_await flujo.eventos.enviar(evento);
+        }
+        flujo.eventosPendientes.clear();
+    }
+
+    flujo.decodificador.finalizarMensaje();
+    for (const Evento& evento : flujo.eventosPendientes) {
+        co_await flujo.eventos.enviar(evento);
+    }
+    flujo.eventosPendientes.clear();
+
+    flujo.eventos.cerrar();
+}
+
+/**
+ * @brief Etapa de salida: muestra los eventos del flujo en consola
+ * @param flujo Flujo a mostrar
+ */
+Tarea etapaSalida(Flujo& flujo) {
+    while (std::optional<Evento> evento = co_await flujo.eventos.recibir()) {
+        switch (evento->tipo) {
+            case Evento::CARACTER:
+                flujo.mensaje += evento->caracter;
+                std::cout << "[" << flujo.ruta << "] Fragmento decodificado: '"
+                          << evento->caracter << "'" << std::endl;
+                break;
+
+            case Evento::RECHAZO:
+                std::cout << "[" << flujo.ruta << "] [ERROR] Trama descartada: "
+                          << evento->texto << std::endl;
+                break;
+
+            case Evento::FIN_MENSAJE:
+                std::cout << "[" << flujo.ruta << "] MENSAJE OCULTO ENSAMBLADO: "
+                          << flujo.mensaje << std::endl;
+                flujo.mensaje.clear();
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Conecta los callbacks del decodificador con la cola de eventos del flujo
+ * @param flujo Flujo a configurar
+ */
+void configurarEventos(Flujo& flujo) {
+    flujo.decodificador.alDecodificar = [&flujo](char caracter) {
+        Evento evento;
+        evento.tipo = Evento::CARACTER;
+        evento.caracter = caracter;
+        evento.texto[0] = '\0';
+        flujo.eventosPendientes.push_back(evento);
+    };
+
+    flujo.decodificador.alRechazarTrama = [&flujo](const char* trama, const char*) {
+        Evento evento;
+        evento.tipo = Evento::RECHAZO;
+        evento.caracter = '\0';
+        strncpy(evento.texto, trama, sizeof(evento.texto) - 1);
+        evento.texto[sizeof(evento.texto) - 1] = '\0';
+        flujo.eventosPendientes.push_back(evento);
+    };
+
+    flujo.decodificador.alFinalizarMensaje = [&flujo](ListaDeCarga&) {
+        Evento evento;
+        evento.tipo = Evento::FIN_MENSAJE;
+        evento.caracter = '\0';
+        evento.texto[0] = '\0';
+        flujo.eventosPendientes.push_back(evento);
+    };
+}
+
+/**
+ * @brief Función principal del modo asíncrono
+ * @param argc Cantidad de argumentos
+ * @param argv Rutas de los puertos a decodificar ("-" = entrada estándar);
+ *             --verificado exige tramas con secuencia y CRC-32C en todos los flujos
+ * @return 0 si todos los flujos se abrieron correctamente, 1 en caso contrario
+ *
+ * Uso: decodificador_async [--verificado] [ruta ...]   (por defecto /dev/ttyUSB0)
+ *
+ * Cada ruta puede aparecer una sola vez: dos flujos sobre el mismo
+ * descriptor competirían por los mismos bytes.
+ */
+int main(int argc, char* argv[])
+{
+    std::cout << "=== Decodificador  PRT-7 (asincrono) ===" << std::endl << std::endl;
+
+    std::vector<std::string> rutas;
+    bool verificado = false;
+    int codigoSalida = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verificado") == 0) {
+            verificado = true;
+        } else if (std::find(rutas.begin(), rutas.end(), argv[i]) != rutas.end()) {
+            std::cerr << "[ERROR] Flujo repetido ignorado: " << argv[i] << std::endl;
+            codigoSalida = 1;
+        } else {
+            rutas.push_back(argv[i]);
+        }
+    }
+    if (rutas.empty()) {
+        rutas.push_back("/dev/ttyUSB0");
+    }
+
+    Reactor reactor;
+    std::vector<std::unique_ptr<Flujo>> flujos;
+
+    for (const std::string& ruta : rutas) {
+        std::unique_ptr<Flujo> flujo(new Flujo(reactor));
+        flujo->ruta = ruta;
+
+        if (ruta == "-") {
+            flujo->descriptor = STDIN_FILENO;
+        } else if (flujo->puerto.abrir(ruta, 9600)) {
+            flujo->descriptor = flujo->puerto.descriptor();
+        } else {
+            codigoSalida = 1;
+            continue;
+        }
+
+        int banderas = fcntl(flujo->descriptor, F_GETFL, 0);
+        fcntl(flujo->descriptor, F_SETFL, banderas | O_NONBLOCK);
+
+        flujo->decodificador.habilitarVerificacion(verificado);
+        // La etapa de enmarcado separa las tramas: debe resincronizar igual que el Decoder
+        flujo->enmarcador.definirInicioTrama(flujo->decodificador.inicioTrama());
+        configurarEventos(*flujo);
+        reactor.lanzar(etapaLectura(reactor, *flujo));
+        reactor.lanzar(etapaEnmarcado(*flujo));
+        reactor.lanzar(etapaDecodificacion(*flujo));
+        reactor.lanzar(etapaSalida(*flujo));
+        flujos.push_back(std::move(flujo));
+    }
+
+    reactor.ejecutar();
+
+    if (verificado) {
+        for (const std::unique_ptr<Flujo>& flujo : flujos) {
+            Decoder::EstadisticasTramas estadisticas = flujo->decodificador.estadisticas();
+            std::cout << "[" << flujo->ruta << "] Tramas validas: " << estadisticas.validas
+                      << " | corruptas: " << estadisticas.corruptas
+                      << " | perdidas: " << estadisticas.perdidas
+                      << " | duplicadas: " << estadisticas.duplicadas << std::endl;
+        }
+    }
+
+    return codigoSalida;
+}